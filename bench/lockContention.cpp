@@ -0,0 +1,121 @@
+#include "compressedVector.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+
+using lockedVector = compressedVector<std::uint64_t, std::int64_t, false, true>;
+
+using plainVector = compressedVector<std::uint64_t, std::int64_t, false, false>;
+
+constexpr std::uint64_t length { 1'000'000 };
+
+constexpr std::uint64_t runLength { length / 10'000 };
+
+
+template<class vectorType>
+[[nodiscard]] vectorType makeVector(void)
+{
+    vectorType vector(0, length, 0);
+
+    for ( std::uint64_t from = 0 ; from < length ; from += runLength )
+        vector.assignValue(from, from + runLength, ( std::int64_t ) ( from / runLength % 7 ));
+
+    return vector;
+}
+
+
+// Runs threadCount threads for duration, each mixing operator[] + getSum reads with assignValue writes, and returns operations per second.
+template<class readType, class writeType>
+[[nodiscard]] double measure(const std::size_t threadCount, const unsigned readShare, const std::chrono::milliseconds duration, const readType& read, const writeType& write)
+{
+    std::atomic<bool> stop { false };
+
+    std::atomic<std::uint64_t> operations { 0 };
+
+    std::vector<std::thread> threads;
+
+    for ( std::size_t thread = 0 ; thread < threadCount ; ++thread )
+        threads.emplace_back([&, thread]
+        {
+            std::mt19937_64 generator { thread };
+
+            std::uint64_t count { 0 };
+
+            for ( ; not stop.load(std::memory_order_relaxed) ; ++count )
+            {
+                const std::uint64_t from { generator() % ( length - runLength ) };
+
+                if ( generator() % 100 < readShare )
+                    read(from);
+
+                else
+                    write(from, ( std::int64_t ) ( generator() % 7 ));
+            }
+
+            operations += count;
+        });
+
+    std::this_thread::sleep_for(duration);
+
+    stop = true;
+
+    for ( auto& thread : threads )
+        thread.join();
+
+    return ( double ) operations.load() * 1000.0 / ( double ) duration.count();
+}
+
+
+// Opposite-order cross-vector operations must finish: locks are taken in address order.
+void crossVectorDeadlockCheck(void)
+{
+    lockedVector a { makeVector<lockedVector>() }, b { makeVector<lockedVector>() };
+
+    std::thread left([&] { for ( int i = 0 ; i < 200 ; ++i ) a += b; });
+
+    std::thread right([&] { for ( int i = 0 ; i < 200 ; ++i ) { b -= a; if ( i % 50 == 0 ) b = a; } });
+
+    left.join();
+
+    right.join();
+
+    std::printf("cross-vector a += b / b -= a / b = a: finished\n");
+}
+
+
+int main(int argc, char** argv)
+{
+    const std::size_t maxThreads { argc > 1 ? ( std::size_t ) std::strtoul(argv[1], nullptr, 10) : 64 };
+
+    const std::chrono::milliseconds duration { argc > 2 ? std::strtol(argv[2], nullptr, 10) : 500 };
+
+    std::printf("threads read%%   built-in ops/s   external ops/s   built-in/external\n");
+
+    for ( const unsigned readShare : { 50u, 90u, 99u } )
+        for ( std::size_t threadCount = 1 ; threadCount <= maxThreads ; threadCount *= 2 )
+        {
+            lockedVector locked { makeVector<lockedVector>() };
+
+            const double builtIn { measure(threadCount, readShare, duration,
+                [&locked](const std::uint64_t from) { volatile std::int64_t sink { locked[from] + locked.getSum(from, from + 64) }; ( void ) sink; },
+                [&locked](const std::uint64_t from, const std::int64_t value) { locked.assignValue(from, from + 16, value); }) };
+
+            plainVector plain { makeVector<plainVector>() };
+
+            std::shared_mutex mutex;
+
+            const double external { measure(threadCount, readShare, duration,
+                [&plain, &mutex](const std::uint64_t from) { const std::shared_lock lock { mutex }; volatile std::int64_t sink { plain[from] + plain.getSum(from, from + 64) }; ( void ) sink; },
+                [&plain, &mutex](const std::uint64_t from, const std::int64_t value) { const std::unique_lock lock { mutex }; plain.assignValue(from, from + 16, value); }) };
+
+            std::printf("%7zu %5u%% %16.0f %16.0f %19.2f\n", threadCount, readShare, builtIn, external, builtIn / external);
+        }
+
+    crossVectorDeadlockCheck();
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -15,10 +16,51 @@
 #include <span>
 #include <cstring>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <bit>
+#include <array>
+#include <ranges>
+#include <queue>
+#include <numeric>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <stdexcept>
+#include <cassert>
+#include <charconv>
+#include <filesystem>
+#include <random>
+
+#ifndef COMPRESSED_VECTOR_X86_KERNELS
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) )
+#define COMPRESSED_VECTOR_X86_KERNELS 1
+#else
+#define COMPRESSED_VECTOR_X86_KERNELS 0
+#endif
+#endif
+
+#if COMPRESSED_VECTOR_X86_KERNELS
+#include <immintrin.h>
+#endif
 
-#define LOCK_READ(threadSafe) if constexpr ( threadSafe ) const std::shared_lock lock(this->mutex);
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstdio>
+#define COMPRESSED_VECTOR_MMAP 1
+#else
+#define COMPRESSED_VECTOR_MMAP 0
+#endif
+
+#define LOCK_READ [[maybe_unused]] const auto readLock { this->lockRead() };
 
-#define LOCK_WRITE(threadSafe) if constexpr ( threadSafe ) const std::unique_lock lock(this->mutex);
+#define LOCK_WRITE [[maybe_unused]] const auto writeLock { this->lockWrite() };
+
+#define LOCK_WITH(exclusive, array, arrayExclusive) [[maybe_unused]] const auto pairLock { this->lockWith(exclusive, array, arrayExclusive) };
 
 
 template<class T> concept Scalar = std::is_scalar_v<T>;
@@ -27,6 +69,8 @@ template<class T> concept BigInteger = std::is_same_v<T, int32_t> or std::is_sam
 
 template<class keyType, class valueType> concept ArithmeticMethodTypes = std::is_arithmetic_v<valueType> and ( sizeof(valueType) >= sizeof(keyType) );
 
+template<class T> concept CompressedExpression = std::remove_cvref_t<T>::isCompressedExpression;
+
 
 template<Scalar T, bool safetyOn = false>
 inline T safeAdd(const T& a, const T& b)
@@ -141,2076 +185,8135 @@ inline void safeDivideAssign(const T& target, const T& argument)
 }
 
 
-template<bool threadSafe>
-class compressedVectorBase {};
-
-
-template<>
-class compressedVectorBase<true>
+template<class valueType>
+class compressedVectorRunEncoder
 {
-    mutable std::shared_mutex mutex;
-};
+    static constexpr bool isFloating { std::is_floating_point_v<valueType> };
 
+    static constexpr bool isVectorizable 
+    { 
+        std::is_arithmetic_v<valueType> and std::has_single_bit(sizeof(valueType)) and sizeof(valueType) <= 8 and ( not isFloating or sizeof(valueType) >= 4 ) 
+    };
 
-template <BigInteger keyType = uint64_t, class valueType = int64_t, bool arithmeticSafe = false, bool threadSafe = false>
-class compressedVector : compressedVectorBase<threadSafe>
-{
-    keyType minIndex, maxIndex;
+    enum class kernelType { scalar, sse, avx2, avx512 };
 
-    valueType m_valBegin;
 
-    std::map<keyType, valueType> m_map;
-
-    /*
-    using value_type             = T;
-    using pointer                = T*;
-    using const_pointer          = const T*;
-    using reference              = value_type&;
-    using const_reference        = const value_type&;
-    using size_type              = std::size_t;                 
-    using difference_type        = std::ptrdiff_t;             
-    using iterator               = // implementation-defined;
-    using const_iterator         = // implementation-defined;
-    using reverse_iterator       = std::reverse_iterator<iterator>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    */
+    template<bool bitwise>
+    [[nodiscard]] static constexpr bool equal(const valueType& a, const valueType& b) noexcept
+    {
+        if constexpr ( bitwise and isFloating and isVectorizable )
+            return std::bit_cast<std::array<std::byte, sizeof(valueType)>>(a) == std::bit_cast<std::array<std::byte, sizeof(valueType)>>(b);
 
+        else if constexpr ( bitwise and isFloating )
+            return std::memcmp(&a, &b, sizeof(valueType)) == 0;
 
-    constexpr compressedVector(const keyType& maxArg, const std::map<keyType, valueType>& mapArg):
-        minIndex{ mapArg.empty() ? maxArg - keyType(1) : mapArg.cbegin()->first }, maxIndex{ maxArg }, 
-        m_valBegin{ mapArg.empty() ? valueType(0) : mapArg.crbegin()->second }, m_map{ mapArg } 
-        {
-            if ( not this->mapCanonicalValidationDebug() )
-                this->reset(valueType(0));
-        }
+        else
+            return a == b;
+    }
 
 
-    /*constexpr compressedVector(const std::initializer_list<std::pair<const keyType, valueType>>& list):
-        //compressedVector(std::empty(list) ? keyType(0) : std::min(list).first, std::empty(list) ? valueType(0) : std::crbegin(list)->second, list){}
-        minIndex{ std::empty(list) ? keyType(0) : std::min(list).first }, maxIndex{ std::numeric_limits<keyType>::max() },
-        m_valBegin{ std::empty(list) ? valueType(0) : std::crbegin(list)->second }, m_map{ list } {}*/
+    template<class functionType>
+    static constexpr void forEachBit(std::uint64_t mask, const std::size_t index, const std::size_t stride, functionType& function)
+    {
+        for ( ; mask ; mask &= mask - 1 )
+            function(index + ( std::size_t ) std::countr_zero(mask) / stride);
+    }
 
 
-    const auto& getMapRef(void) const noexcept { return this->m_map; }
+    [[nodiscard]] static constexpr std::uint64_t laneBits(const std::size_t bytes) noexcept
+    {
+        std::uint64_t bits { 0 };
 
+        for ( std::size_t bit = 0; bit < bytes; bit += sizeof(valueType) )
+            bits |= std::uint64_t(1) << bit;
 
-public:
+        return bits;
+    }
 
-    using value_type = valueType;
 
-    using key_type = keyType;
+    template<bool bitwise, class functionType>
+    static constexpr void scanScalar(const valueType* data, std::size_t index, const std::size_t size, functionType& function)
+    {
+        for ( ; index < size ; ++index )
+            if ( not equal<bitwise>(data[index], data[index - 1]) )
+                function(index);
+    }
 
+#if COMPRESSED_VECTOR_X86_KERNELS
 
-    constexpr compressedVector():
-        minIndex{ keyType(0) }, maxIndex{ keyType(1) }, m_valBegin{ valueType(0) }, m_map{} {}
+    [[nodiscard]] static kernelType selectKernel(void)
+    {
+        __builtin_cpu_init();
 
+        if ( __builtin_cpu_supports("avx512bw") )
+            return kernelType::avx512;
 
-    constexpr explicit compressedVector(const valueType& initValue):
-        minIndex{ keyType(0) }, maxIndex{ keyType(1) }, m_valBegin{ initValue }, m_map{} {}
+        if ( __builtin_cpu_supports("avx2") )
+            return kernelType::avx2;
 
+        if ( __builtin_cpu_supports("sse4.2") )
+            return kernelType::sse;
 
-    constexpr compressedVector
-    (
-        const keyType& minIndexArg, 
-        const keyType& maxIndexArg, 
-        const valueType& initValue
-    ):
-        minIndex{ std::min(minIndexArg, maxIndexArg) }, maxIndex{ std::max(maxIndexArg, minIndexArg) }, m_valBegin{ initValue }, m_map{} {}
+        return kernelType::scalar;
+    }
 
 
-    constexpr compressedVector
-    (
-        keyType minIndexArg, 
-        const valueType& initValue, 
-        const std::vector<std::pair<valueType, std::size_t>>& vectorValues
-    ):
-        minIndex{ minIndexArg }, 
-        maxIndex{ std::ranges::fold_left(vectorValues, minIndexArg, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; }) },
-        m_valBegin{ initValue }, 
-        m_map{}
+    template<bool bitwise, class functionType>
+    __attribute__((target("sse4.2"))) static std::size_t scanSse(const valueType* data, const std::size_t size, functionType& function)
     {
-        this->assignValues(vectorValues);
-    }
+        constexpr std::size_t lanes { 16 / sizeof(valueType) };
 
+        std::size_t index { 1 };
 
-    constexpr compressedVector(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& other):
-        minIndex{ other.minIndex }, maxIndex{ other.maxIndex }, m_valBegin { other.m_valBegin }, m_map { other.m_map } {}
+        for ( ; index + lanes <= size ; index += lanes )
+        {
+            if constexpr ( isFloating and not bitwise and sizeof(valueType) == 4 )
+                forEachBit(( std::uint64_t ) _mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(( const float* ) data + index), _mm_loadu_ps(( const float* ) data + index - 1))), index, 1, function);
 
+            else if constexpr ( isFloating and not bitwise )
+                forEachBit(( std::uint64_t ) _mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(( const double* ) data + index), _mm_loadu_pd(( const double* ) data + index - 1))), index, 1, function);
 
-    constexpr compressedVector<keyType, valueType, threadSafe>& operator=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& other) & noexcept
-    {
-        this->minIndex = other.minIndex;
+            else
+            {
+                const __m128i current { _mm_loadu_si128(( const __m128i* ) ( data + index )) }, previous { _mm_loadu_si128(( const __m128i* ) ( data + index - 1 )) };
 
-        this->maxIndex = other.maxIndex;
+                __m128i equalLanes;
 
-        this->m_valBegin = other.m_valBegin;
+                if constexpr ( sizeof(valueType) == 1 )
+                    equalLanes = _mm_cmpeq_epi8(current, previous);
 
-        this->m_map = other.m_map;
+                else if constexpr ( sizeof(valueType) == 2 )
+                    equalLanes = _mm_cmpeq_epi16(current, previous);
 
-        return *this;
-    }
+                else if constexpr ( sizeof(valueType) == 4 )
+                    equalLanes = _mm_cmpeq_epi32(current, previous);
 
+                else
+                    equalLanes = _mm_cmpeq_epi64(current, previous);
+
+                forEachBit(~( std::uint64_t ) _mm_movemask_epi8(equalLanes) & laneBits(16), index, sizeof(valueType), function);
+            }
+        }
 
-    constexpr compressedVector(compressedVector<keyType, valueType, arithmeticSafe, threadSafe>&& other):
-        minIndex{ other.minIndex }, maxIndex{ other.maxIndex }, m_valBegin { other.m_valBegin }, m_map { std::move(other.m_map) } {}
+        return index;
+    }
 
 
-    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& operator=(compressedVector<keyType, valueType, arithmeticSafe, threadSafe>&& other) & noexcept
+    template<bool bitwise, class functionType>
+    __attribute__((target("avx2"))) static std::size_t scanAvx2(const valueType* data, const std::size_t size, functionType& function)
     {
-        if ( this == &other )
+        constexpr std::size_t lanes { 32 / sizeof(valueType) };
+
+        std::size_t index { 1 };
+
+        for ( ; index + lanes <= size ; index += lanes )
         {
-            this->minIndex = other.minIndex;
+            if constexpr ( isFloating and not bitwise and sizeof(valueType) == 4 )
+                forEachBit(( std::uint64_t ) _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(( const float* ) data + index), _mm256_loadu_ps(( const float* ) data + index - 1), _CMP_NEQ_UQ)), index, 1, function);
 
-            this->maxIndex = other.maxIndex;
+            else if constexpr ( isFloating and not bitwise )
+                forEachBit(( std::uint64_t ) _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(( const double* ) data + index), _mm256_loadu_pd(( const double* ) data + index - 1), _CMP_NEQ_UQ)), index, 1, function);
 
-            this->m_valBegin = other.m_valBegin;
+            else
+            {
+                const __m256i current { _mm256_loadu_si256(( const __m256i* ) ( data + index )) }, previous { _mm256_loadu_si256(( const __m256i* ) ( data + index - 1 )) };
 
-            this->m_map = std::move(other.m_map);
+                __m256i equalLanes;
+
+                if constexpr ( sizeof(valueType) == 1 )
+                    equalLanes = _mm256_cmpeq_epi8(current, previous);
+
+                else if constexpr ( sizeof(valueType) == 2 )
+                    equalLanes = _mm256_cmpeq_epi16(current, previous);
+
+                else if constexpr ( sizeof(valueType) == 4 )
+                    equalLanes = _mm256_cmpeq_epi32(current, previous);
+
+                else
+                    equalLanes = _mm256_cmpeq_epi64(current, previous);
+
+                forEachBit(~( std::uint64_t ) ( std::uint32_t ) _mm256_movemask_epi8(equalLanes) & laneBits(32), index, sizeof(valueType), function);
+            }
         }
 
-        return *this;
+        return index;
     }
 
 
-    constexpr void reset(const valueType& value)
+    template<bool bitwise, class functionType>
+    __attribute__((target("avx512f,avx512bw"))) static std::size_t scanAvx512(const valueType* data, const std::size_t size, functionType& function)
     {
-        this->m_valBegin = value;
+        constexpr std::size_t lanes { 64 / sizeof(valueType) };
 
-        this->m_map.clear();
-    }
+        std::size_t index { 1 };
 
+        for ( ; index + lanes <= size ; index += lanes )
+        {
+            std::uint64_t mask;
 
-    [[nodiscard]] constexpr const valueType& operator[](keyType const& key) const 
-    {
-        if( const auto& it = this->m_map.upper_bound(key); it not_eq this->m_map.cbegin() )
-            return std::prev(it)->second;
-        else 
-            return this->m_valBegin;
-    }
+            if constexpr ( isFloating and not bitwise and sizeof(valueType) == 4 )
+                mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(( const float* ) data + index), _mm512_loadu_ps(( const float* ) data + index - 1), _CMP_NEQ_UQ);
 
+            else if constexpr ( isFloating and not bitwise )
+                mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(( const double* ) data + index), _mm512_loadu_pd(( const double* ) data + index - 1), _CMP_NEQ_UQ);
 
-    [[nodiscard]] constexpr bool operator==(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& other) const = default;
-    
+            else
+            {
+                const __m512i current { _mm512_loadu_si512(data + index) }, previous { _mm512_loadu_si512(data + index - 1) };
 
-    [[nodiscard]] constexpr const auto& getInitialValue(void) const noexcept
-    {
-        return this->m_valBegin;
+                if constexpr ( sizeof(valueType) == 1 )
+                    mask = _mm512_cmpneq_epi8_mask(current, previous);
+
+                else if constexpr ( sizeof(valueType) == 2 )
+                    mask = _mm512_cmpneq_epi16_mask(current, previous);
+
+                else if constexpr ( sizeof(valueType) == 4 )
+                    mask = _mm512_cmpneq_epi32_mask(current, previous);
+
+                else
+                    mask = _mm512_cmpneq_epi64_mask(current, previous);
+            }
+
+            forEachBit(mask, index, 1, function);
+        }
+
+        return index;
     }
 
+#endif
 
-    [[nodiscard]] constexpr std::size_t getMapSize(void) const noexcept 
-    { 
-        return this->m_map.size(); 
+    [[nodiscard]] static kernelType activeKernel(void)
+    {
+#if COMPRESSED_VECTOR_X86_KERNELS
+        if constexpr ( isVectorizable )
+        {
+            static const kernelType selected { selectKernel() };
+
+            return selected;
+        }
+#endif
+        return kernelType::scalar;
     }
 
 
-    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    template<bool bitwise, class functionType>
+    static constexpr void scan(const std::span<const valueType> buffer, functionType& function)
     {
-        const auto size = 2 * sizeof(keyType) + sizeof(valueType) + sizeof(decltype(this->m_map)) + sizeof(typename decltype(this->m_map)::value_type) * this->m_map.size();
+        if ( buffer.size() < 2 )
+            return;
 
-        if constexpr ( threadSafe )
-            return size + sizeof(decltype(this->mutex));
+        std::size_t index { 1 };
 
-        else
-            return size;
-    }
+        if !consteval
+        {
+#if COMPRESSED_VECTOR_X86_KERNELS
+            if constexpr ( isVectorizable )
+            {
+                switch ( activeKernel() )
+                {
+                    case kernelType::avx512: index = scanAvx512<bitwise>(buffer.data(), buffer.size(), function); break;
 
+                    case kernelType::avx2: index = scanAvx2<bitwise>(buffer.data(), buffer.size(), function); break;
 
-    [[nodiscard]] constexpr keyType getMinIndex(void) const noexcept 
-    { 
-        return this->minIndex;
-    }
+                    case kernelType::sse: index = scanSse<bitwise>(buffer.data(), buffer.size(), function); break;
 
+                    case kernelType::scalar: break;
+                }
+            }
+#endif
+        }
 
-    [[nodiscard]] constexpr keyType getMaxIndex(void) const noexcept 
-    { 
-        return this->maxIndex;
+        scanScalar<bitwise>(buffer.data(), index, buffer.size(), function);
     }
 
+public:
 
-    [[nodiscard]] constexpr std::pair<keyType, keyType> getMinMaxIndex(void) const
+    template<bool bitwise = false>
+    [[nodiscard]] static constexpr bool isSameRun(const valueType& a, const valueType& b) noexcept
     {
-        return { this->minIndex, this->maxIndex };
+        return equal<bitwise>(a, b);
     }
 
 
-    [[nodiscard]] constexpr auto getLength(void) const noexcept
+    // Calls function(index) in increasing order for every index i > 0 with buffer[i] not equal to buffer[i - 1].
+    // With bitwiseEquality, floating values are compared by their bits: NaNs with the same payload form one run, -0.0 and 0.0 do not.
+    template<class functionType>
+    static constexpr void forEachRunBoundary(const std::span<const valueType> buffer, const bool bitwiseEquality, functionType&& function)
     {
-        return ( std::size_t ) ( this->maxIndex - this->minIndex );
+        if ( bitwiseEquality )
+            scan<true>(buffer, function);
+
+        else
+            scan<false>(buffer, function);
     }
 
 
-    [[nodiscard]] constexpr std::pair<keyType, keyType> getValidRange
-    (
-        const keyType& from, 
-        const keyType& to
-    ) const
+    [[nodiscard]] static std::string_view getKernelName(void)
     {
-        if ( to <= from )
-            return { from, from };
+        constexpr std::array<std::string_view, 4> names { "scalar", "sse4.2", "avx2", "avx512" };
 
-        if ( to <= this->minIndex )
-            return { this->minIndex, this->minIndex };
+        return names[( std::size_t ) activeKernel()];
+    }
+};
 
-        if ( this->maxIndex <= from )
-            return { this->maxIndex, this->maxIndex };
 
-        return { this->minIndex <= from ? from : this->minIndex, to <= this->maxIndex ? to : this->maxIndex };
-    }
+class compressedVectorMappedFile
+{
+    const char* m_data { nullptr };
 
+    std::size_t m_size { 0 };
 
-    [[nodiscard]] constexpr bool contains
-    (
-        const keyType& fromArg, 
-        const keyType& toArg,
-        const valueType& value
-    ) const
+    bool m_isOpen { false };
+
+#if COMPRESSED_VECTOR_MMAP
+    void* m_mapping { nullptr };
+#else
+    std::vector<char> m_buffer;
+#endif
+
+public:
+
+    explicit compressedVectorMappedFile(std::string_view filePath)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+#if COMPRESSED_VECTOR_MMAP
+        std::FILE* const stream { std::fopen(std::string(filePath).c_str(), "rb") };
 
-        if ( from == to ) 
-            return false;
+        if ( not stream )
+            return;
 
-        if ( this->m_map.empty() )
-            return this->m_valBegin == value;
+        const int descriptor { ::fileno(stream) };
 
-        const auto itBegin = this->m_map.lower_bound(from);
-        const auto itEnd = this->m_map.lower_bound(to);
+        struct stat status {};
+
+        if ( ::fstat(descriptor, &status) == 0 )
+        {
+            this->m_size = ( std::size_t ) status.st_size;
 
-        if ( itEnd == this->m_map.cbegin() )
-            return this->m_valBegin == value;
+            this->m_isOpen = true;
 
-        if ( itBegin == this->m_map.cend() )
-            return this->m_map.crbegin()->second == value;
+            if ( this->m_size )
+            {
+                this->m_mapping = ::mmap(nullptr, this->m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
 
-        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
+                if ( this->m_mapping == MAP_FAILED )
+                {
+                    this->m_mapping = nullptr;
 
-        return ( prevItBeginVal == value ) or ( std::find_if(itBegin, itEnd, 
-            [&value](const std::pair<const keyType, valueType>& p) { return p.second == value; }) not_eq this->m_map.cend() );   
-    }
+                    this->m_size = 0;
 
+                    this->m_isOpen = false;
+                }
 
-    [[nodiscard]] constexpr bool contains(const valueType& value) const
-    {
-        return this->contains(this->minIndex, this->maxIndex, value);
-    }
+                else
+                {
+                    ::madvise(this->m_mapping, this->m_size, MADV_SEQUENTIAL);
 
+                    this->m_data = ( const char* ) this->m_mapping;
+                }
+            }
+        }
 
-    [[maybe_unused]] constexpr bool setMinIndex(const keyType& index)
-    {
-        if ( index >= this->maxIndex )
-            return false;
+        std::fclose(stream);
+#else
+        std::ifstream file(std::string(filePath), std::ios::binary);
 
-        this->minIndex = index;
+        if ( not file.is_open() )
+            return;
 
-        this->m_map.erase( this->m_map.cbegin(), this->m_map.lower_bound(index) );
+        this->m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
 
-        return true;
+        this->m_data = this->m_buffer.data();
+
+        this->m_size = this->m_buffer.size();
+
+        this->m_isOpen = true;
+#endif
     }
 
 
-    [[maybe_unused]] constexpr bool setMaxIndex(const keyType& index)
-    {
-        if ( index <= this->minIndex )
-            return false;
+    compressedVectorMappedFile(const compressedVectorMappedFile&) = delete;
 
-        this->maxIndex = index;
+    compressedVectorMappedFile& operator=(const compressedVectorMappedFile&) = delete;
 
-        this->m_map.erase( this->m_map.upper_bound(index), this->m_map.cend() );
 
-        return true;
+    ~compressedVectorMappedFile()
+    {
+#if COMPRESSED_VECTOR_MMAP
+        if ( this->m_mapping )
+            ::munmap(this->m_mapping, this->m_size);
+#endif
     }
 
 
-    [[maybe_unused]] constexpr bool setMinMaxIndex
-    (
-        const keyType& minIndexArg, 
-        const keyType& maxIndexArg
-    )
+    [[nodiscard]] bool isOpen(void) const noexcept
     {
-        return this->setMinIndex(minIndexArg) and this->setMaxIndex(maxIndexArg);
+        return this->m_isOpen;
     }
 
 
-    constexpr void setInitValue(const valueType& value)
+    [[nodiscard]] std::string_view getText(void) const noexcept
     {
-        this->m_valBegin = value;
+        return { this->m_data, this->m_size };
+    }
 
-        if ( this->m_map.empty() )
-            return;
 
-        if ( value == this->m_map.cbegin()->second )
-            this->m_map.erase(this->m_map.cbegin());
+    [[nodiscard]] std::span<const std::byte> getBytes(void) const noexcept
+    {
+        return { ( const std::byte* ) this->m_data, this->m_size };
+    }
+};
 
-        if ( this->m_map.size() == 1 )
-        {
-            this->m_map.clear();
 
-            return;
-        }
+class compressedVectorTextIndex
+{
+    static constexpr std::uint64_t magic { 0x3178646976632e00 };
 
-        this->m_map.rbegin()->second = value;
-    }
+    static constexpr std::uint64_t version { 2 };
 
+    std::size_t m_stride { 4096 };
 
-    constexpr void assignValue
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const valueType& value
-    )
+    std::size_t m_count { 0 };
+
+    std::vector<std::uint64_t> m_offsets;
+
+
+    [[nodiscard]] static std::pair<std::uint64_t, std::int64_t> fileStamp(const std::string_view filePath)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        std::error_code error;
 
-        if ( from == to ) 
-            return;
+        const auto size { std::filesystem::file_size(filePath, error) };
 
-        if ( m_map.empty() )
-        {
-            if ( value not_eq this->m_valBegin )
-                this->m_map = { { from, value }, { to, this->m_valBegin } };
+        const auto time { std::filesystem::last_write_time(filePath, error) };
 
-            return;
-        }
+        if ( error )
+            return { 0, 0 };
 
-        typename decltype(this->m_map)::iterator itBegin, itEnd = this->m_map.lower_bound(to);
+        return { ( std::uint64_t ) size, ( std::int64_t ) time.time_since_epoch().count() };
+    }
 
-        if ( itEnd == this->m_map.cend() )
+
+    [[nodiscard]] static bool startsToken(const std::string_view text, const std::size_t position) noexcept
+    {
+        return not isSpace(text[position]) and ( position == 0 or isSpace(text[position - 1]) );
+    }
+
+
+    // A cached index is trusted only if every offset starts a token in text and the tokens after the last offset complete the recorded count.
+    [[nodiscard]] bool matches(const std::string_view text) const
+    {
+        if ( this->m_offsets.empty() )
+            return this->m_count == 0 and std::ranges::all_of(text, isSpace);
+
+        if ( std::ranges::adjacent_find(this->m_offsets, std::greater_equal{}) not_eq this->m_offsets.cend() )
+            return false;
+
+        for ( const std::uint64_t offset : this->m_offsets )
+            if ( offset >= text.size() or not startsToken(text, ( std::size_t ) offset) )
+                return false;
+
+        std::size_t remaining { this->m_count - ( this->m_offsets.size() - 1 ) * this->m_stride };
+
+        for ( std::size_t position = ( std::size_t ) this->m_offsets.back(); position < text.size(); ++position )
+            if ( startsToken(text, position) and remaining-- == 0 )
+                return false;
+
+        return remaining == 0;
+    }
+
+public:
+
+    compressedVectorTextIndex(void) = default;
+
+
+    [[nodiscard]] static constexpr bool isSpace(const char c) noexcept
+    {
+        return c == ' ' or ( c >= '\t' and c <= '\r' );
+    }
+
+
+    // Records the byte offset of every stride-th whitespace-separated token, counting tokens in parallel chunks of the text.
+    [[nodiscard]] static compressedVectorTextIndex build(const std::string_view text, const std::size_t stride = 4096)
+    {
+        compressedVectorTextIndex index;
+
+        index.m_stride = std::max<std::size_t>(stride, 1);
+
+        const std::size_t chunkCount { std::clamp<std::size_t>(text.size() >> 20, 1, std::max(1u, std::thread::hardware_concurrency())) };
+
+        std::vector<std::size_t> chunks(chunkCount), counts(chunkCount + 1, 0);
+
+        std::iota(chunks.begin(), chunks.end(), std::size_t(0));
+
+        const auto chunkBegin = [&text, &chunkCount](const std::size_t chunk) { return text.size() * chunk / chunkCount; };
+
+        std::for_each(std::execution::par, chunks.cbegin(), chunks.cend(), [&](const std::size_t chunk)
         {
-            if ( value not_eq this->m_valBegin )
-                itEnd = this->m_map.emplace_hint(itEnd, to, this->m_valBegin);
+            for ( std::size_t position = chunkBegin(chunk), end = chunkBegin(chunk + 1); position < end; ++position )
+                counts[chunk + 1] += startsToken(text, position);
+        });
 
-            itBegin = std::prev(itEnd);
-        }
+        std::partial_sum(counts.cbegin(), counts.cend(), counts.begin());
 
-        else
+        index.m_count = counts.back();
+
+        index.m_offsets.resize(( index.m_count + index.m_stride - 1 ) / index.m_stride);
+
+        std::for_each(std::execution::par, chunks.cbegin(), chunks.cend(), [&](const std::size_t chunk)
         {
-            if ( itEnd == this->m_map.cbegin() )
-            {
-                if ( to < itEnd->first and value not_eq this->m_valBegin )
-                    itEnd = this->m_map.emplace_hint(itEnd, to, this->m_valBegin);
-            }
+            std::size_t token { counts[chunk] };
 
-            else if ( const valueType& prevItEndVal = std::prev(itEnd)->second; to < itEnd->first and value not_eq prevItEndVal )
-                itEnd = this->m_map.emplace_hint(itEnd, to, prevItEndVal);
+            for ( std::size_t position = chunkBegin(chunk), end = chunkBegin(chunk + 1); position < end; ++position )
+                if ( startsToken(text, position) and token++ % index.m_stride == 0 )
+                    index.m_offsets[( token - 1 ) / index.m_stride] = position;
+        });
 
-            itBegin = itEnd;
-        }
+        return index;
+    }
 
-        for ( ; itBegin not_eq this->m_map.cbegin() and from < itBegin->first ; --itBegin );
 
-        if ( itBegin->first < from )
-            ++itBegin;
+    // Loads the index cached next to the file when it matches the file's size and modification time, otherwise builds it and tries to cache it.
+    [[nodiscard]] static compressedVectorTextIndex forFile(const std::string_view filePath, const std::string_view text, const std::size_t strideArg = 4096)
+    {
+        const std::size_t stride { std::max<std::size_t>(strideArg, 1) };
 
-        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
+        const std::string indexPath { std::string(filePath) + ".cvidx" };
 
-        if ( from < itBegin->first )
+        const auto [size, time] = fileStamp(filePath);
+
+        std::ifstream input(indexPath, std::ios::binary);
+
+        std::array<std::uint64_t, 7> header {};
+
+        std::error_code error;
+
+        const auto indexSize { std::filesystem::file_size(indexPath, error) };
+
+        if ( not error and input.read(( char* ) header.data(), sizeof(header)) and std::ranges::equal(std::span{ header }.first<5>(), std::array<std::uint64_t, 5>{ magic, version, size, ( std::uint64_t ) time, stride })
+             and header[6] == ( header[5] + stride - 1 ) / stride and indexSize == sizeof(header) + header[6] * sizeof(std::uint64_t) )
         {
-            const auto& itEndErase = this->m_map.erase(itBegin, itEnd not_eq this->m_map.cend() and itEnd->second == value ? std::next(itEnd) : itEnd);
-            
-            if ( value not_eq prevItBeginVal )
-                this->m_map.emplace_hint(itEndErase, from, value);
+            compressedVectorTextIndex index;
+
+            index.m_stride = stride;
+
+            index.m_count = header[5];
+
+            index.m_offsets.resize(header[6]);
+
+            if ( input.read(( char* ) index.m_offsets.data(), ( std::streamsize ) ( index.m_offsets.size() * sizeof(std::uint64_t) )) and index.matches(text) )
+                return index;
         }
 
-        else
+        compressedVectorTextIndex index { build(text, stride) };
+
+        // Written to a private file in the same directory and renamed over the cache, so readers never see a partial index.
+        const std::string temporaryPath { indexPath + ".tmp" + std::to_string(std::random_device{}()) };
+
         {
-            if ( value not_eq prevItBeginVal )
-                (itBegin++)->second = value;
-        
-            this->m_map.erase(itBegin, itEnd not_eq this->m_map.cend() and itEnd->second == value ? std::next(itEnd) : itEnd);
+            std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+
+            header = { magic, version, size, ( std::uint64_t ) time, index.m_stride, index.m_count, index.m_offsets.size() };
+
+            output.write(( const char* ) header.data(), sizeof(header));
+
+            output.write(( const char* ) index.m_offsets.data(), ( std::streamsize ) ( index.m_offsets.size() * sizeof(std::uint64_t) ));
+
+            output.close();
+
+            if ( output )
+                std::filesystem::rename(temporaryPath, indexPath, error);
         }
+
+        std::filesystem::remove(temporaryPath, error);
+
+        return index;
     }
 
 
-    constexpr void assignValues(const std::vector<std::pair<valueType, std::size_t>>& values)
+    [[nodiscard]] std::size_t getCount(void) const noexcept
     {
-        this->assignValues(this->minIndex, this->maxIndex, values);
+        return this->m_count;
     }
 
 
-    constexpr void assignValues
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const std::vector<std::pair<valueType, std::size_t>>& values
-    )
+    // Returns the text starting at the token with index tokenIndex, skipping at most stride - 1 tokens from the nearest recorded offset.
+    [[nodiscard]] std::string_view seek(const std::string_view text, const std::size_t tokenIndex) const
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        if ( tokenIndex >= this->m_count )
+            return {};
 
-        if ( from == to or values.empty() ) 
-            return;
+        std::size_t position { ( std::size_t ) this->m_offsets[tokenIndex / this->m_stride] };
 
-        std::size_t startIndex { 0 }, reduceFirst { 0 };
+        for ( std::size_t skip = tokenIndex % this->m_stride; skip and position < text.size(); --skip )
+        {
+            while ( position < text.size() and not isSpace(text[position]) )
+                ++position;
 
-        auto diff = from - fromArg;
+            while ( position < text.size() and isSpace(text[position]) )
+                ++position;
+        }
 
-        if ( std::cmp_greater(diff, 0) )
-        {
-            for ( const auto& item : values )
-            {   
-                diff -= ( keyType ) item.second;
+        if ( position >= text.size() )
+            return {};
 
-                if ( std::cmp_less(diff, 0) )
-                {
-                    reduceFirst = item.second - ( std::size_t ) -diff ;
+        return text.substr(position);
+    }
+};
 
-                    break;
-                }
 
-                ++startIndex;
-            }
-        }
+class compressedVectorMutex
+{
+    template<std::size_t count>
+    friend class compressedVectorLock;
 
-        if ( std::cmp_equal(startIndex, values.size()) )
-            return;
+    std::shared_mutex m_mutex;
 
-        std::vector<std::pair<valueType, std::size_t>> fixedValues = { values[startIndex] };
+    // Every mutex this thread holds, with whether it holds it exclusively.
+    inline static thread_local std::vector<std::pair<const compressedVectorMutex*, bool>> heldByThisThread {};
+};
 
-        fixedValues.front().second -= reduceFirst;
 
-        const std::size_t rangeSize = ( std::size_t ) std::llround(std::ceil(to - from));
+using compressedVectorLockRequest = std::pair<compressedVectorMutex*, bool>;
 
-        std::size_t size { fixedValues.front().second };
 
-        for ( std::size_t index { startIndex + 1 } ; index not_eq values.size() and size < rangeSize ; )
-        {
-            const auto& item = values[index++];
+template<std::size_t count>
+class compressedVectorLock
+{
+    std::array<compressedVectorLockRequest, count> m_locks {};
 
-            if ( item.first not_eq fixedValues.back().first )
-            {
-                if ( item.second )
-                    fixedValues.push_back(item);
-            }
+    std::size_t m_size { 0 };
 
-            else
-                fixedValues.back().second += item.second;
 
-            size += item.second;
-        }
+    void release(void) noexcept
+    {
+        auto& held = compressedVectorMutex::heldByThisThread;
 
-        if ( size > rangeSize )
+        while ( this->m_size > 0 )
         {
-            fixedValues.back().second -= (size - rangeSize);
+            const auto [mutex, exclusive] = this->m_locks[--this->m_size];
 
-            size = rangeSize;
+            if ( exclusive )
+                mutex->m_mutex.unlock();
+            else
+                mutex->m_mutex.unlock_shared();
+
+            held.erase(std::find(held.begin(), held.end(), std::pair<const compressedVectorMutex*, bool>{ mutex, exclusive }));
         }
+    }
 
-        if ( std::cmp_equal(fixedValues.back().second, 0) )
-            fixedValues.pop_back();
+public:
 
-        if ( fixedValues.empty() )
-            return;
+    explicit compressedVectorLock(std::array<compressedVectorLockRequest, count> requests)
+    {
+        std::sort(requests.begin(), requests.end(), [](const auto& a, const auto& b) { return std::less<compressedVectorMutex*>{}(a.first, b.first); });
 
-        if ( std::cmp_equal(fixedValues.size(), 1) )
+        auto& held = compressedVectorMutex::heldByThisThread;
+
+        for ( std::size_t i = 0 ; i < count ; ++i )
         {
-            this->assignValue(from, from + ( keyType ) fixedValues.front().second, fixedValues.front().first);
+            const auto [mutex, exclusive] = requests[i];
 
-            return;
-        }
+            if ( mutex == nullptr )
+                continue;
 
-        if ( m_map.empty() )
-        {
-            keyType position = ( keyType ) from;
+            if ( i + 1 < count and requests[i + 1].first == mutex )
+            {
+                requests[i + 1].second = requests[i + 1].second or exclusive;
 
-            for ( const auto& item : fixedValues )
+                continue;
+            }
+
+            if ( const auto it = std::find_if(held.cbegin(), held.cend(), [mutex](const auto& entry) { return entry.first == mutex; }); it not_eq held.cend() )
             {
-                this->m_map.emplace_hint(this->m_map.cend(), position, item.first);
+                if ( exclusive and not it->second )
+                {
+                    this->release();
 
-                position += ( keyType ) item.second;
+                    throw std::logic_error("compressedVectorLock: cannot write to a vector while this thread holds it with lockRead()");
+                }
+
+                continue;
             }
 
-            if ( ( not this->m_map.empty() ) and this->m_map.crbegin()->second not_eq this->m_valBegin )
-                this->m_map.emplace_hint(this->m_map.cend(), position, this->m_valBegin);
+            if ( exclusive )
+                mutex->m_mutex.lock();
+            else
+                mutex->m_mutex.lock_shared();
 
-            if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
-                this->m_map.erase(this->m_map.cbegin());
+            held.emplace_back(mutex, exclusive);
 
-            return;
+            this->m_locks[this->m_size++] = { mutex, exclusive };
         }
+    }
 
-        const auto positionTemp = from + ( keyType ) size - ( keyType ) fixedValues.back().second;
 
-        auto position { positionTemp };
+    compressedVectorLock(const compressedVectorLock<count>&) = delete;
 
-        this->assignValue(from, from + ( keyType ) fixedValues.front().second, fixedValues.front().first);
+    compressedVectorLock<count>& operator=(const compressedVectorLock<count>&) = delete;
 
-        this->assignValue(( keyType ) position, from + ( keyType ) size, fixedValues.back().first);
 
-        if ( std::cmp_equal(fixedValues.size(), 2) )
-            return;
+    ~compressedVectorLock()
+    {
+        this->release();
+    }
+};
 
-        const auto secondPrevEndIt = std::prev(fixedValues.cend(), 2);
 
-        position -= ( decltype(position) ) secondPrevEndIt->second;
+struct compressedVectorNoLock {};
 
-        this->assignValue(( keyType ) position, positionTemp, secondPrevEndIt->first);
 
-        if ( std::cmp_equal(fixedValues.size(), 3) )
-            return;
+template<bool threadSafe>
+class compressedVectorBase 
+{
+protected:
 
-        auto it = std::prev(this->m_map.find(positionTemp));
+    [[nodiscard]] constexpr compressedVectorLockRequest lockRequest(const bool) const noexcept
+    {
+        return { nullptr, false };
+    }
 
-        this->m_map.erase(this->m_map.upper_bound(from), it);
+public:
 
-        if ( std::cmp_not_equal(it->first, position) )
-            it = this->m_map.emplace_hint(this->m_map.erase(it), position, secondPrevEndIt->first);
+    [[nodiscard]] constexpr compressedVectorNoLock lockRead(void) const noexcept 
+    { 
+        return {}; 
+    }
 
-        for ( auto valuesIt { std::prev(fixedValues.cend(), 3) } ; valuesIt not_eq fixedValues.cbegin() ; --valuesIt )
+
+    [[nodiscard]] constexpr compressedVectorNoLock lockWrite(void) const noexcept 
+    { 
+        return {}; 
+    }
+};
+
+
+template<>
+class compressedVectorBase<true>
+{
+protected:
+
+    mutable compressedVectorMutex mutex;
+
+
+    [[nodiscard]] compressedVectorLockRequest lockRequest(const bool exclusive) const noexcept
+    {
+        return { &this->mutex, exclusive };
+    }
+
+public:
+
+    [[nodiscard]] compressedVectorLock<1> lockRead(void) const 
+    { 
+        return compressedVectorLock<1>{ { this->lockRequest(false) } }; 
+    }
+
+
+    [[nodiscard]] compressedVectorLock<1> lockWrite(void) const 
+    { 
+        return compressedVectorLock<1>{ { this->lockRequest(true) } }; 
+    }
+};
+
+
+template<class keyType, class valueType>
+class flatMap
+{
+    std::vector<keyType> m_keys;
+
+    std::vector<valueType> m_values;
+
+
+    template<bool isConst>
+    class iteratorBase
+    {
+        friend class flatMap<keyType, valueType>;
+
+        friend class iteratorBase<not isConst>;
+
+        using mapPointer = std::conditional_t<isConst, const flatMap<keyType, valueType>*, flatMap<keyType, valueType>*>;
+
+        mapPointer m_owner;
+
+        std::size_t m_index;
+
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+
+        using value_type = std::pair<keyType, valueType>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = std::pair<const keyType&, std::conditional_t<isConst, const valueType&, valueType&>>;
+
+        struct pointer
         {
-            position -= ( decltype(position) ) valuesIt->second;
+            reference ref;
+
+            constexpr const reference* operator->(void) const noexcept { return &this->ref; }
+        };
+
+
+        constexpr iteratorBase(): m_owner{ nullptr }, m_index{ 0 } {}
+
+
+        constexpr iteratorBase(mapPointer owner, std::size_t index): m_owner{ owner }, m_index{ index } {}
+
+
+        template<bool otherConst, class = std::enable_if_t<isConst and not otherConst>>
+        constexpr iteratorBase(const iteratorBase<otherConst>& other): m_owner{ other.m_owner }, m_index{ other.m_index } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const 
+        { 
+            return { this->m_owner->m_keys[this->m_index], this->m_owner->m_values[this->m_index] }; 
+        }
+
+
+        [[nodiscard]] constexpr pointer operator->(void) const 
+        { 
+            return { **this }; 
+        }
+
+
+        [[nodiscard]] constexpr reference operator[](const difference_type offset) const 
+        { 
+            return *(*this + offset); 
+        }
+
+
+        constexpr iteratorBase& operator++(void) noexcept { ++this->m_index; return *this; }
+
+        constexpr iteratorBase& operator--(void) noexcept { --this->m_index; return *this; }
+
+        constexpr iteratorBase operator++(int) noexcept { auto temp = *this; ++this->m_index; return temp; }
+
+        constexpr iteratorBase operator--(int) noexcept { auto temp = *this; --this->m_index; return temp; }
+
+        constexpr iteratorBase& operator+=(const difference_type offset) noexcept { this->m_index += offset; return *this; }
+
+        constexpr iteratorBase& operator-=(const difference_type offset) noexcept { this->m_index -= offset; return *this; }
+
+        [[nodiscard]] constexpr iteratorBase operator+(const difference_type offset) const noexcept { return { this->m_owner, this->m_index + offset }; }
+
+        [[nodiscard]] constexpr iteratorBase operator-(const difference_type offset) const noexcept { return { this->m_owner, this->m_index - offset }; }
+
+        [[nodiscard]] friend constexpr iteratorBase operator+(const difference_type offset, const iteratorBase& it) noexcept { return it + offset; }
+
+
+        template<bool otherConst>
+        [[nodiscard]] constexpr difference_type operator-(const iteratorBase<otherConst>& other) const noexcept 
+        { 
+            return ( difference_type ) this->m_index - ( difference_type ) other.m_index; 
+        }
+
+
+        template<bool otherConst>
+        [[nodiscard]] constexpr bool operator==(const iteratorBase<otherConst>& other) const noexcept 
+        { 
+            return this->m_index == other.m_index; 
+        }
+
+
+        template<bool otherConst>
+        [[nodiscard]] constexpr auto operator<=>(const iteratorBase<otherConst>& other) const noexcept 
+        { 
+            return this->m_index <=> other.m_index; 
+        }
+    };
+
+
+public:
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = iteratorBase<false>;
+
+    using const_iterator = iteratorBase<true>;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    constexpr flatMap() = default;
+
+
+    constexpr flatMap(const std::initializer_list<value_type>& list)
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    constexpr flatMap& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const flatMap<keyType, valueType>& other) const = default;
+
+
+    [[nodiscard]] constexpr iterator begin(void) noexcept { return { this, 0 }; }
+
+    [[nodiscard]] constexpr iterator end(void) noexcept { return { this, this->m_keys.size() }; }
+
+    [[nodiscard]] constexpr const_iterator begin(void) const noexcept { return { this, 0 }; }
+
+    [[nodiscard]] constexpr const_iterator end(void) const noexcept { return { this, this->m_keys.size() }; }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const noexcept { return this->begin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const noexcept { return this->end(); }
+
+    [[nodiscard]] constexpr reverse_iterator rbegin(void) noexcept { return reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr reverse_iterator rend(void) noexcept { return reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const noexcept { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const noexcept { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const noexcept { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const noexcept { return this->rend(); }
+
+
+    [[nodiscard]] constexpr bool empty(void) const noexcept 
+    { 
+        return this->m_keys.empty(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t size(void) const noexcept 
+    { 
+        return this->m_keys.size(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        return sizeof(flatMap<keyType, valueType>) + this->m_keys.capacity() * sizeof(keyType) + this->m_values.capacity() * sizeof(valueType);
+    }
+
+
+    constexpr void clear(void) noexcept
+    {
+        this->m_keys.clear();
+
+        this->m_values.clear();
+    }
+
+
+    constexpr void reserve(const std::size_t size)
+    {
+        this->m_keys.reserve(size);
+
+        this->m_values.reserve(size);
+    }
+
+
+    constexpr void shrink_to_fit(void)
+    {
+        this->m_keys.shrink_to_fit();
+
+        this->m_values.shrink_to_fit();
+    }
+
+
+    [[nodiscard]] constexpr std::span<const keyType> getKeys(void) const noexcept 
+    { 
+        return this->m_keys; 
+    }
+
+
+    [[nodiscard]] constexpr std::span<const valueType> getValues(void) const noexcept 
+    { 
+        return this->m_values; 
+    }
+
+
+    [[nodiscard]] constexpr iterator lower_bound(const keyType& key) 
+    { 
+        return { this, this->lowerBoundIndex(key) }; 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator lower_bound(const keyType& key) const 
+    { 
+        return { this, this->lowerBoundIndex(key) }; 
+    }
+
+
+    [[nodiscard]] constexpr iterator upper_bound(const keyType& key) 
+    { 
+        return { this, this->upperBoundIndex(key) }; 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator upper_bound(const keyType& key) const 
+    { 
+        return { this, this->upperBoundIndex(key) }; 
+    }
+
+
+    template<class functionType>
+    constexpr void upperBoundIndices(std::span<const keyType> keys, functionType&& function) const
+    {
+        constexpr std::size_t groupSize { 16 };
+
+        const std::size_t size { this->m_keys.size() };
+
+        const keyType* const data { this->m_keys.data() };
+
+        std::array<std::size_t, groupSize> bases;
+
+        for ( std::size_t groupBegin = 0; groupBegin < keys.size(); groupBegin += groupSize )
+        {
+            const std::size_t groupLength { std::min(groupSize, keys.size() - groupBegin) };
+
+            bases.fill(0);
+
+            std::size_t length { size };
+
+            while ( length > 1 )
+            {
+                const std::size_t half { length / 2 };
+
+                for ( std::size_t index = 0; index < groupLength; ++index )
+                {
+                    if not consteval
+                    {
+                        __builtin_prefetch(data + bases[index] + half / 2);
+
+                        __builtin_prefetch(data + bases[index] + half + half / 2);
+                    }
+                }
+
+                for ( std::size_t index = 0; index < groupLength; ++index )
+                    bases[index] += ( data[bases[index] + half] <= keys[groupBegin + index] ) ? half : 0;
+
+                length -= half;
+            }
+
+            for ( std::size_t index = 0; index < groupLength; ++index )
+                function(groupBegin + index, bases[index] + ( size not_eq 0 and data[bases[index]] <= keys[groupBegin + index] ));
+        }
+    }
+
+
+    [[nodiscard]] constexpr iterator find(const keyType& key)
+    {
+        const auto index = this->lowerBoundIndex(key);
+
+        return { this, index not_eq this->m_keys.size() and this->m_keys[index] == key ? index : this->m_keys.size() };
+    }
+
+
+    [[nodiscard]] constexpr const_iterator find(const keyType& key) const
+    {
+        const auto index = this->lowerBoundIndex(key);
+
+        return { this, index not_eq this->m_keys.size() and this->m_keys[index] == key ? index : this->m_keys.size() };
+    }
+
+
+    constexpr std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        return this->emplaceAt(this->lowerBoundIndex(key), key, value);
+    }
+
+
+    constexpr iterator emplace_hint(const_iterator hint, const keyType& key, const valueType& value)
+    {
+        const auto size = this->m_keys.size();
+
+        auto index = hint.m_index;
+
+        if ( ( index not_eq size and this->m_keys[index] < key ) or ( index not_eq 0 and key < this->m_keys[index - 1] ) )
+            index = this->lowerBoundIndex(key);
+
+        return this->emplaceAt(index, key, value).first;
+    }
+
+
+    constexpr iterator erase(const_iterator position)
+    {
+        this->m_keys.erase(this->m_keys.cbegin() + ( std::ptrdiff_t ) position.m_index);
+
+        this->m_values.erase(this->m_values.cbegin() + ( std::ptrdiff_t ) position.m_index);
+
+        return { this, position.m_index };
+    }
+
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        this->m_keys.erase(this->m_keys.cbegin() + ( std::ptrdiff_t ) first.m_index, this->m_keys.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+        this->m_values.erase(this->m_values.cbegin() + ( std::ptrdiff_t ) first.m_index, this->m_values.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+        return { this, first.m_index };
+    }
+
+
+    constexpr iterator shiftKeys(const_iterator first, const_iterator last, const keyType& difference)
+    {
+        std::for_each(this->m_keys.begin() + ( std::ptrdiff_t ) first.m_index, this->m_keys.begin() + ( std::ptrdiff_t ) last.m_index, 
+            [&difference](keyType& key) { key += difference; });
+
+        return { this, first.m_index };
+    }
+
+
+private:
+
+    [[nodiscard]] constexpr std::size_t lowerBoundIndex(const keyType& key) const
+    {
+        return ( std::size_t ) std::distance(this->m_keys.cbegin(), std::lower_bound(this->m_keys.cbegin(), this->m_keys.cend(), key));
+    }
+
+
+    [[nodiscard]] constexpr std::size_t upperBoundIndex(const keyType& key) const
+    {
+        return ( std::size_t ) std::distance(this->m_keys.cbegin(), std::upper_bound(this->m_keys.cbegin(), this->m_keys.cend(), key));
+    }
+
+
+    constexpr std::pair<iterator, bool> emplaceAt(const std::size_t index, const keyType& key, const valueType& value)
+    {
+        if ( index not_eq this->m_keys.size() and this->m_keys[index] == key )
+            return { { this, index }, false };
+
+        this->m_keys.insert(this->m_keys.cbegin() + ( std::ptrdiff_t ) index, key);
+
+        this->m_values.insert(this->m_values.cbegin() + ( std::ptrdiff_t ) index, value);
+
+        return { { this, index }, true };
+    }
+};
+
+
+template<class mapType>
+constexpr auto shiftStorageKeys
+(
+    mapType& map,
+    typename mapType::iterator first, 
+    typename mapType::iterator last, 
+    const typename mapType::key_type& difference
+)
+{
+    if constexpr ( requires { map.shiftKeys(first, last, difference); } )
+        return map.shiftKeys(first, last, difference);
+
+    else
+    {
+        std::vector<typename mapType::node_type> nodes;
+
+        for ( auto it = first; it not_eq last; )
+        {
+            nodes.push_back(map.extract(it++));
+
+            nodes.back().key() += difference;
+        }
+
+        for ( auto it = nodes.rbegin(); it not_eq nodes.rend(); ++it )
+            last = map.insert(last, std::move(*it));
+
+        return last;
+    }
+}
+
+
+template<class keyType, class valueType, class innerType = std::map<keyType, valueType>>
+class offsetMap
+{
+    innerType m_map;
+
+    keyType m_offset;
+
+
+    // Keys below the offset would wrap in unsigned arithmetic, so every stored key is kept at or above it and clamped on lookup.
+    [[nodiscard]] constexpr keyType relative(const keyType& key) const noexcept
+    {
+        return key < this->m_offset ? keyType(0) : key - this->m_offset;
+    }
+
+
+    // Lowers the offset to key, raising every stored key by the same amount.
+    constexpr void rebase(const keyType& key)
+    {
+        if ( not this->m_map.empty() )
+            shiftStorageKeys(this->m_map, this->m_map.begin(), this->m_map.end(), this->m_offset - key);
+
+        this->m_offset = key;
+    }
+
+
+    template<bool isConst>
+    class iteratorBase
+    {
+        friend class offsetMap<keyType, valueType, innerType>;
+
+        friend class iteratorBase<not isConst>;
+
+        using innerIterator = std::conditional_t<isConst, typename innerType::const_iterator, typename innerType::iterator>;
+
+        innerIterator m_it;
+
+        keyType m_offset;
+
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = std::pair<keyType, valueType>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = std::pair<const keyType, decltype(( std::declval<innerIterator>()->second ))>;
+
+        struct pointer
+        {
+            reference ref;
+
+            constexpr const reference* operator->(void) const noexcept { return &this->ref; }
+        };
+
+
+        constexpr iteratorBase(): m_it{}, m_offset{ keyType(0) } {}
+
+
+        constexpr iteratorBase(const innerIterator& it, const keyType& offset): m_it{ it }, m_offset{ offset } {}
+
+
+        template<bool otherConst, class = std::enable_if_t<isConst and not otherConst>>
+        constexpr iteratorBase(const iteratorBase<otherConst>& other): m_it{ other.m_it }, m_offset{ other.m_offset } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const 
+        { 
+            return { this->m_it->first + this->m_offset, this->m_it->second }; 
+        }
+
+
+        [[nodiscard]] constexpr pointer operator->(void) const 
+        { 
+            return { **this }; 
+        }
+
+
+        constexpr iteratorBase& operator++(void) { ++this->m_it; return *this; }
+
+        constexpr iteratorBase& operator--(void) { --this->m_it; return *this; }
+
+        constexpr iteratorBase operator++(int) { auto temp = *this; ++this->m_it; return temp; }
+
+        constexpr iteratorBase operator--(int) { auto temp = *this; --this->m_it; return temp; }
+
+
+        template<bool otherConst>
+        [[nodiscard]] constexpr bool operator==(const iteratorBase<otherConst>& other) const 
+        { 
+            return this->m_it == other.m_it; 
+        }
+    };
+
+
+public:
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = iteratorBase<false>;
+
+    using const_iterator = iteratorBase<true>;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    constexpr offsetMap(): m_map{}, m_offset{ keyType(0) } {}
+
+
+    constexpr offsetMap(const std::initializer_list<value_type>& list): offsetMap()
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    constexpr offsetMap& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const offsetMap<keyType, valueType, innerType>& other) const
+    {
+        return std::equal(this->cbegin(), this->cend(), other.cbegin(), other.cend(), 
+            [](const auto& a, const auto& b) { return a.first == b.first and a.second == b.second; });
+    }
+
+
+    [[nodiscard]] constexpr iterator begin(void) { return { this->m_map.begin(), this->m_offset }; }
+
+    [[nodiscard]] constexpr iterator end(void) { return { this->m_map.end(), this->m_offset }; }
+
+    [[nodiscard]] constexpr const_iterator begin(void) const { return { this->m_map.cbegin(), this->m_offset }; }
+
+    [[nodiscard]] constexpr const_iterator end(void) const { return { this->m_map.cend(), this->m_offset }; }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->begin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->end(); }
+
+    [[nodiscard]] constexpr reverse_iterator rbegin(void) { return reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr reverse_iterator rend(void) { return reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
+
+
+    [[nodiscard]] constexpr bool empty(void) const noexcept 
+    { 
+        return this->m_map.empty(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t size(void) const noexcept 
+    { 
+        return this->m_map.size(); 
+    }
+
+
+    [[nodiscard]] constexpr keyType getOffset(void) const noexcept 
+    { 
+        return this->m_offset; 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        if constexpr ( requires { this->m_map.getByteSize(); } )
+            return sizeof(keyType) + this->m_map.getByteSize();
+
+        else
+            return sizeof(offsetMap<keyType, valueType, innerType>) + sizeof(value_type) * this->m_map.size();
+    }
+
+
+    constexpr void clear(void)
+    {
+        this->m_map.clear();
+
+        this->m_offset = keyType(0);
+    }
+
+
+    [[nodiscard]] constexpr iterator lower_bound(const keyType& key) 
+    { 
+        return { this->m_map.lower_bound(this->relative(key)), this->m_offset }; 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator lower_bound(const keyType& key) const 
+    { 
+        return { this->m_map.lower_bound(this->relative(key)), this->m_offset }; 
+    }
+
+
+    [[nodiscard]] constexpr iterator upper_bound(const keyType& key) 
+    { 
+        return key < this->m_offset ? this->begin() : iterator{ this->m_map.upper_bound(key - this->m_offset), this->m_offset }; 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator upper_bound(const keyType& key) const 
+    { 
+        return key < this->m_offset ? this->begin() : const_iterator{ this->m_map.upper_bound(key - this->m_offset), this->m_offset }; 
+    }
+
+
+    [[nodiscard]] constexpr iterator find(const keyType& key) 
+    { 
+        return key < this->m_offset ? this->end() : iterator{ this->m_map.find(key - this->m_offset), this->m_offset }; 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator find(const keyType& key) const 
+    { 
+        return key < this->m_offset ? this->end() : const_iterator{ this->m_map.find(key - this->m_offset), this->m_offset }; 
+    }
+
+
+    constexpr std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        if ( key < this->m_offset )
+            this->rebase(key);
+
+        const auto [it, inserted] = this->m_map.emplace(key - this->m_offset, value);
+
+        return { { it, this->m_offset }, inserted };
+    }
+
+
+    constexpr iterator emplace_hint(const_iterator hint, const keyType& key, const valueType& value)
+    {
+        if ( key < this->m_offset )
+            return this->emplace(key, value).first;
+
+        return { this->m_map.emplace_hint(hint.m_it, key - this->m_offset, value), this->m_offset };
+    }
+
+
+    constexpr iterator erase(const_iterator position)
+    {
+        return { this->m_map.erase(position.m_it), this->m_offset };
+    }
+
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        return { this->m_map.erase(first.m_it, last.m_it), this->m_offset };
+    }
+
+
+    constexpr void assign(iterator position, const valueType& value)
+    {
+        if constexpr ( requires { this->m_map.assign(position.m_it, value); } )
+            this->m_map.assign(position.m_it, value);
+
+        else
+            position.m_it->second = value;
+    }
+
+
+    [[nodiscard]] constexpr valueType prefixSum(const keyType& key) const requires requires(const innerType& map) { map.prefixSum(key); }
+    {
+        return this->m_map.prefixSum(this->relative(key));
+    }
+
+
+    [[nodiscard]] constexpr auto rangeMinimum(const keyType& from, const keyType& to) const requires requires(const innerType& map) { map.rangeMinimum(from, to); }
+    {
+        return this->m_map.rangeMinimum(this->relative(from), this->relative(to));
+    }
+
+
+    [[nodiscard]] constexpr auto rangeMaximum(const keyType& from, const keyType& to) const requires requires(const innerType& map) { map.rangeMaximum(from, to); }
+    {
+        return this->m_map.rangeMaximum(this->relative(from), this->relative(to));
+    }
+
+
+    constexpr iterator shiftKeys(iterator first, iterator last, const keyType& difference)
+    {
+        if ( first.m_it == last.m_it )
+            return last;
+
+        const keyType offset = this->m_offset + difference, firstKey = first->first + difference;
+
+        if ( first.m_it == this->m_map.begin() and last.m_it == this->m_map.end() )
+        {
+            // A downward shift past zero would wrap the offset above the keys, so the first key becomes the new offset instead.
+            if ( firstKey < offset )
+                shiftStorageKeys(this->m_map, this->m_map.begin(), this->m_map.end(), keyType(0) - this->m_map.begin()->first);
+
+            this->m_offset = std::min(offset, firstKey);
+
+            return this->begin();
+        }
+
+        if ( first.m_it == this->m_map.begin() and firstKey < this->m_offset )
+        {
+            // The shifted prefix would fall below the offset: lower the offset to its new first key and raise the untouched suffix to match.
+            const keyType lowering = this->m_offset - firstKey;
+
+            const auto result = shiftStorageKeys(this->m_map, first.m_it, last.m_it, difference + lowering);
+
+            if ( last.m_it not_eq this->m_map.end() )
+                shiftStorageKeys(this->m_map, last.m_it, this->m_map.end(), lowering);
+
+            this->m_offset = firstKey;
+
+            return { result, this->m_offset };
+        }
+
+        return { shiftStorageKeys(this->m_map, first.m_it, last.m_it, difference), this->m_offset };
+    }
+};
+
+
+template<class keyType, class valueType>
+using offsetFlatMap = offsetMap<keyType, valueType, flatMap<keyType, valueType>>;
+
+template<class keyType, class valueType>
+class runLengthTree
+{
+    static constexpr bool isArithmetic = std::is_arithmetic_v<valueType>;
+
+    static constexpr bool isOrdered = std::totally_ordered<valueType>;
+
+    struct noAggregate {};
+
+    struct node
+    {
+        keyType length, span;
+
+        valueType value;
+
+        node *left, *right, *parent;
+
+        std::uint64_t priority;
+
+        [[no_unique_address]] std::conditional_t<isArithmetic, valueType, noAggregate> sum {};
+
+        [[no_unique_address]] std::conditional_t<isOrdered, valueType, noAggregate> minimum {}, maximum {};
+    };
+
+
+    node* m_root;
+
+    keyType m_base;
+
+    std::size_t m_size;
+
+    std::uint64_t m_seed;
+
+
+    template<bool isConst>
+    class iteratorBase
+    {
+        friend class runLengthTree<keyType, valueType>;
+
+        friend class iteratorBase<not isConst>;
+
+        const runLengthTree<keyType, valueType>* m_owner;
+
+        node* m_node;
+
+        keyType m_key;
+
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = std::pair<keyType, valueType>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = std::pair<const keyType, const valueType&>;
+
+        struct pointer
+        {
+            reference ref;
+
+            constexpr const reference* operator->(void) const noexcept { return &this->ref; }
+        };
+
+
+        constexpr iteratorBase(): m_owner{ nullptr }, m_node{ nullptr }, m_key{ keyType(0) } {}
+
+
+        constexpr iteratorBase(const runLengthTree<keyType, valueType>* owner, node* nodeArg, const keyType& key): 
+            m_owner{ owner }, m_node{ nodeArg }, m_key{ key } {}
+
+
+        template<bool otherConst, class = std::enable_if_t<isConst and not otherConst>>
+        constexpr iteratorBase(const iteratorBase<otherConst>& other): m_owner{ other.m_owner }, m_node{ other.m_node }, m_key{ other.m_key } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const 
+        { 
+            return { this->m_key, this->m_node->value }; 
+        }
+
+
+        [[nodiscard]] constexpr pointer operator->(void) const 
+        { 
+            return { **this }; 
+        }
+
+
+        constexpr iteratorBase& operator++(void)
+        {
+            this->m_key += this->m_node->length;
+
+            this->m_node = runLengthTree<keyType, valueType>::successor(this->m_node);
+
+            return *this;
+        }
+
+
+        constexpr iteratorBase& operator--(void)
+        {
+            if ( this->m_node == nullptr )
+            {
+                this->m_node = runLengthTree<keyType, valueType>::rightmost(this->m_owner->m_root);
+
+                this->m_key = this->m_owner->m_base + this->m_owner->m_root->span - this->m_node->length;
+            }
+
+            else
+            {
+                this->m_node = runLengthTree<keyType, valueType>::predecessor(this->m_node);
+
+                this->m_key -= this->m_node->length;
+            }
+
+            return *this;
+        }
+
+
+        constexpr iteratorBase operator++(int) { auto temp = *this; ++*this; return temp; }
+
+        constexpr iteratorBase operator--(int) { auto temp = *this; --*this; return temp; }
+
+
+        template<bool otherConst>
+        [[nodiscard]] constexpr bool operator==(const iteratorBase<otherConst>& other) const noexcept 
+        { 
+            return this->m_node == other.m_node; 
+        }
+    };
+
+
+public:
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = iteratorBase<false>;
+
+    using const_iterator = iteratorBase<true>;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    constexpr runLengthTree(): m_root{ nullptr }, m_base{ keyType(0) }, m_size{ 0 }, m_seed{ 0x9E3779B97F4A7C15ull } {}
+
+
+    constexpr runLengthTree(const std::initializer_list<value_type>& list): runLengthTree()
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    constexpr runLengthTree(const runLengthTree<keyType, valueType>& other):
+        m_root{ runLengthTree<keyType, valueType>::clone(other.m_root, nullptr) }, m_base{ other.m_base }, m_size{ other.m_size }, m_seed{ other.m_seed } {}
+
+
+    constexpr runLengthTree(runLengthTree<keyType, valueType>&& other) noexcept:
+        m_root{ std::exchange(other.m_root, nullptr) }, m_base{ other.m_base }, m_size{ std::exchange(other.m_size, 0) }, m_seed{ other.m_seed } {}
+
+
+    constexpr runLengthTree& operator=(runLengthTree<keyType, valueType> other) noexcept
+    {
+        std::swap(this->m_root, other.m_root);
+
+        std::swap(this->m_base, other.m_base);
+
+        std::swap(this->m_size, other.m_size);
+
+        std::swap(this->m_seed, other.m_seed);
+
+        return *this;
+    }
+
+
+    constexpr runLengthTree& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    constexpr ~runLengthTree()
+    {
+        this->clear();
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const runLengthTree<keyType, valueType>& other) const
+    {
+        return std::equal(this->cbegin(), this->cend(), other.cbegin(), other.cend(), 
+            [](const auto& a, const auto& b) { return a.first == b.first and a.second == b.second; });
+    }
+
+
+    [[nodiscard]] constexpr iterator begin(void) { return { this, runLengthTree<keyType, valueType>::leftmost(this->m_root), this->m_base }; }
+
+    [[nodiscard]] constexpr iterator end(void) { return { this, nullptr, keyType(0) }; }
+
+    [[nodiscard]] constexpr const_iterator begin(void) const { return { this, runLengthTree<keyType, valueType>::leftmost(this->m_root), this->m_base }; }
+
+    [[nodiscard]] constexpr const_iterator end(void) const { return { this, nullptr, keyType(0) }; }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->begin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->end(); }
+
+    [[nodiscard]] constexpr reverse_iterator rbegin(void) { return reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr reverse_iterator rend(void) { return reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
+
+
+    [[nodiscard]] constexpr bool empty(void) const noexcept 
+    { 
+        return this->m_root == nullptr; 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t size(void) const noexcept 
+    { 
+        return this->m_size; 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        return sizeof(runLengthTree<keyType, valueType>) + sizeof(node) * this->m_size;
+    }
+
+
+    constexpr void clear(void) noexcept
+    {
+        runLengthTree<keyType, valueType>::destroy(this->m_root);
+
+        this->m_root = nullptr;
+
+        this->m_base = keyType(0);
+
+        this->m_size = 0;
+    }
+
+
+    [[nodiscard]] constexpr iterator lower_bound(const keyType& key) { return this->bound<false, iterator>(key); }
+
+    [[nodiscard]] constexpr const_iterator lower_bound(const keyType& key) const { return this->bound<false, const_iterator>(key); }
+
+    [[nodiscard]] constexpr iterator upper_bound(const keyType& key) { return this->bound<true, iterator>(key); }
+
+    [[nodiscard]] constexpr const_iterator upper_bound(const keyType& key) const { return this->bound<true, const_iterator>(key); }
+
+
+    [[nodiscard]] constexpr iterator find(const keyType& key)
+    {
+        const auto it = this->lower_bound(key);
+
+        return it not_eq this->end() and it->first == key ? it : this->end();
+    }
+
+
+    [[nodiscard]] constexpr const_iterator find(const keyType& key) const
+    {
+        const auto it = this->lower_bound(key);
+
+        return it not_eq this->end() and it->first == key ? it : this->end();
+    }
+
+
+    constexpr std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        const auto itNext = this->lower_bound(key);
+
+        if ( itNext not_eq this->end() and itNext->first == key )
+            return { itNext, false };
+
+        node* newNode = new node{ keyType(0), keyType(0), value, nullptr, nullptr, nullptr, this->nextPriority() };
+
+        ++this->m_size;
+
+        if ( this->m_root == nullptr )
+        {
+            this->m_root = newNode;
+
+            this->m_base = key;
+
+            return { { this, newNode, key }, true };
+        }
+
+        if ( itNext == this->begin() )
+        {
+            newNode->length = this->m_base - key;
+
+            this->m_base = key;
+
+            this->attach(newNode, itNext.m_node, true);
+
+            return { { this, newNode, key }, true };
+        }
+
+        const auto itPrev = std::prev(itNext);
+
+        node* prevNode = itPrev.m_node;
+
+        if ( itNext not_eq this->end() )
+            newNode->length = itNext->first - key;
+
+        prevNode->length = key - itPrev->first;
+
+        runLengthTree<keyType, valueType>::refresh(prevNode);
+
+        if ( prevNode->right == nullptr )
+            this->attach(newNode, prevNode, false);
+
+        else
+            this->attach(newNode, itNext.m_node, true);
+
+        return { { this, newNode, key }, true };
+    }
+
+
+    constexpr iterator emplace_hint(const_iterator, const keyType& key, const valueType& value)
+    {
+        return this->emplace(key, value).first;
+    }
+
+
+    [[nodiscard]] constexpr std::optional<valueType> rangeMinimum(const keyType& from, const keyType& to) const requires isOrdered
+    {
+        return this->rangeExtremeByKey<false>(from, to);
+    }
+
+
+    [[nodiscard]] constexpr std::optional<valueType> rangeMaximum(const keyType& from, const keyType& to) const requires isOrdered
+    {
+        return this->rangeExtremeByKey<true>(from, to);
+    }
+
+
+    constexpr void assign(iterator position, const valueType& value)
+    {
+        position.m_node->value = value;
+
+        runLengthTree<keyType, valueType>::refresh(position.m_node);
+    }
+
+
+    [[nodiscard]] constexpr valueType prefixSum(const keyType& key) const requires isArithmetic
+    {
+        if ( this->m_root == nullptr or key <= this->m_base )
+            return valueType(0);
+
+        const keyType target = key - this->m_base;
+
+        valueType result { 0 };
+
+        keyType accumulated { 0 };
+
+        for ( const node* x = this->m_root ; x not_eq nullptr ; )
+        {
+            const keyType offset = accumulated + runLengthTree<keyType, valueType>::spanOf(x->left);
+
+            if ( target <= offset )
+                x = x->left;
+
+            else if ( target < offset + x->length )
+                return result + runLengthTree<keyType, valueType>::sumOf(x->left) + ( valueType ) ( target - offset ) * x->value;
+
+            else
+            {
+                result += runLengthTree<keyType, valueType>::sumOf(x->left) + ( valueType ) x->length * x->value;
+
+                accumulated = offset + x->length;
+
+                x = x->right;
+            }
+        }
+
+        return result;
+    }
+
+
+    constexpr iterator erase(const_iterator position)
+    {
+        node* target = position.m_node;
+
+        node* prevNode = runLengthTree<keyType, valueType>::predecessor(target);
+
+        node* nextNode = runLengthTree<keyType, valueType>::successor(target);
+
+        const keyType nextKey = position.m_key + target->length;
+
+        if ( prevNode == nullptr )
+            this->m_base = nextKey;
+
+        else
+        {
+            prevNode->length = ( nextNode == nullptr ? keyType(0) : prevNode->length + target->length );
+
+            runLengthTree<keyType, valueType>::refresh(prevNode);
+        }
+
+        this->detach(target);
+
+        delete target;
+
+        --this->m_size;
+
+        return { this, nextNode, nextKey };
+    }
+
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        while ( first not_eq last )
+            first = this->erase(first);
+
+        return { this, last.m_node, last.m_key };
+    }
+
+
+    constexpr iterator shiftKeys(iterator first, iterator last, const keyType& difference)
+    {
+        if ( first == last )
+            return first;
+
+        if ( node* prevNode = runLengthTree<keyType, valueType>::predecessor(first.m_node); prevNode == nullptr )
+            this->m_base += difference;
+
+        else
+        {
+            prevNode->length += difference;
+
+            runLengthTree<keyType, valueType>::refresh(prevNode);
+        }
+
+        if ( last.m_node not_eq nullptr )
+        {
+            node* lastNode = runLengthTree<keyType, valueType>::predecessor(last.m_node);
+
+            lastNode->length -= difference;
+
+            runLengthTree<keyType, valueType>::refresh(lastNode);
+        }
+
+        return { this, first.m_node, first.m_key + difference };
+    }
+
+
+private:
+
+    [[nodiscard]] static constexpr keyType spanOf(const node* x) noexcept
+    {
+        return x == nullptr ? keyType(0) : x->span;
+    }
+
+
+    [[nodiscard]] static constexpr valueType sumOf(const node* x) noexcept requires isArithmetic
+    {
+        return x == nullptr ? valueType(0) : x->sum;
+    }
+
+
+    static constexpr void update(node* x) noexcept
+    {
+        x->span = x->length + runLengthTree<keyType, valueType>::spanOf(x->left) + runLengthTree<keyType, valueType>::spanOf(x->right);
+
+        if constexpr ( isArithmetic )
+            x->sum = ( valueType ) x->length * x->value + runLengthTree<keyType, valueType>::sumOf(x->left) + runLengthTree<keyType, valueType>::sumOf(x->right);
+
+        if constexpr ( isOrdered )
+        {
+            x->minimum = x->maximum = x->value;
+
+            for ( const node* child : { x->left, x->right } )
+            {
+                if ( child not_eq nullptr )
+                {
+                    x->minimum = std::min(x->minimum, child->minimum);
+
+                    x->maximum = std::max(x->maximum, child->maximum);
+                }
+            }
+        }
+    }
+
+
+    template<bool maximum>
+    [[nodiscard]] static constexpr std::optional<valueType> rangeExtreme
+    (
+        const node* x, 
+        const keyType& start, 
+        const keyType& from, 
+        const keyType& to
+    ) requires isOrdered
+    {
+        if ( x == nullptr or to <= start or start + x->span < from )
+            return std::nullopt;
+
+        if ( from <= start and start + x->span < to )
+            return maximum ? x->maximum : x->minimum;
+
+        const keyType offset = start + runLengthTree<keyType, valueType>::spanOf(x->left);
+
+        std::optional<valueType> result = runLengthTree<keyType, valueType>::rangeExtreme<maximum>(x->left, start, from, to);
+
+        for ( const auto& candidate : { ( from <= offset and offset < to ? std::optional<valueType>{ x->value } : std::nullopt ), 
+            runLengthTree<keyType, valueType>::rangeExtreme<maximum>(x->right, offset + x->length, from, to) } )
+        {
+            if ( candidate and ( not result or ( maximum ? *result < *candidate : *candidate < *result ) ) )
+                result = candidate;
+        }
+
+        return result;
+    }
+
+
+    static constexpr void refresh(node* x) noexcept
+    {
+        for ( ; x not_eq nullptr ; x = x->parent )
+            runLengthTree<keyType, valueType>::update(x);
+    }
+
+
+    [[nodiscard]] static constexpr node* leftmost(node* x) noexcept
+    {
+        if ( x not_eq nullptr )
+            for ( ; x->left not_eq nullptr ; x = x->left );
+
+        return x;
+    }
+
+
+    [[nodiscard]] static constexpr node* rightmost(node* x) noexcept
+    {
+        if ( x not_eq nullptr )
+            for ( ; x->right not_eq nullptr ; x = x->right );
+
+        return x;
+    }
+
+
+    [[nodiscard]] static constexpr node* successor(node* x) noexcept
+    {
+        if ( x->right not_eq nullptr )
+            return runLengthTree<keyType, valueType>::leftmost(x->right);
+
+        for ( ; x->parent not_eq nullptr and x->parent->right == x ; x = x->parent );
+
+        return x->parent;
+    }
+
+
+    [[nodiscard]] static constexpr node* predecessor(node* x) noexcept
+    {
+        if ( x->left not_eq nullptr )
+            return runLengthTree<keyType, valueType>::rightmost(x->left);
+
+        for ( ; x->parent not_eq nullptr and x->parent->left == x ; x = x->parent );
+
+        return x->parent;
+    }
+
+
+    [[nodiscard]] static constexpr node* clone(const node* x, node* parent)
+    {
+        if ( x == nullptr )
+            return nullptr;
+
+        node* copy = new node{ *x };
+
+        copy->parent = parent;
+
+        copy->left = runLengthTree<keyType, valueType>::clone(x->left, copy);
+
+        copy->right = runLengthTree<keyType, valueType>::clone(x->right, copy);
+
+        return copy;
+    }
+
+
+    static constexpr void destroy(node* x) noexcept
+    {
+        if ( x == nullptr )
+            return;
+
+        runLengthTree<keyType, valueType>::destroy(x->left);
+
+        runLengthTree<keyType, valueType>::destroy(x->right);
+
+        delete x;
+    }
+
+
+    constexpr std::uint64_t nextPriority(void) noexcept
+    {
+        this->m_seed ^= this->m_seed << 13;
+
+        this->m_seed ^= this->m_seed >> 7;
+
+        this->m_seed ^= this->m_seed << 17;
+
+        return this->m_seed;
+    }
+
+
+    template<bool maximum>
+    [[nodiscard]] constexpr std::optional<valueType> rangeExtremeByKey(const keyType& from, const keyType& to) const requires isOrdered
+    {
+        if ( this->m_root == nullptr or to <= from or to <= this->m_base )
+            return std::nullopt;
+
+        return runLengthTree<keyType, valueType>::rangeExtreme<maximum>(this->m_root, keyType(0), 
+            from <= this->m_base ? keyType(0) : from - this->m_base, to - this->m_base);
+    }
+
+
+    template<bool upper, class iteratorType>
+    [[nodiscard]] constexpr iteratorType bound(const keyType& key) const
+    {
+        if ( this->m_root == nullptr or key < this->m_base or ( not upper and key == this->m_base ) )
+            return { this, runLengthTree<keyType, valueType>::leftmost(this->m_root), this->m_base };
+
+        const keyType target = key - this->m_base;
+
+        keyType accumulated { 0 }, foundOffset { 0 };
+
+        node *x = this->m_root, *found = nullptr;
+
+        while ( x not_eq nullptr )
+        {
+            const keyType offset = accumulated + runLengthTree<keyType, valueType>::spanOf(x->left);
+
+            if ( upper ? offset > target : offset >= target )
+            {
+                found = x;
+
+                foundOffset = offset;
+
+                x = x->left;
+            }
+
+            else
+            {
+                accumulated = offset + x->length;
+
+                x = x->right;
+            }
+        }
+
+        return { this, found, this->m_base + foundOffset };
+    }
+
+
+    constexpr void rotateUp(node* x) noexcept
+    {
+        node* parent = x->parent;
+
+        node* grandParent = parent->parent;
+
+        if ( parent->left == x )
+        {
+            parent->left = x->right;
+
+            if ( x->right not_eq nullptr )
+                x->right->parent = parent;
+
+            x->right = parent;
+        }
+
+        else
+        {
+            parent->right = x->left;
+
+            if ( x->left not_eq nullptr )
+                x->left->parent = parent;
+
+            x->left = parent;
+        }
+
+        parent->parent = x;
+
+        x->parent = grandParent;
+
+        if ( grandParent == nullptr )
+            this->m_root = x;
+
+        else if ( grandParent->left == parent )
+            grandParent->left = x;
+
+        else
+            grandParent->right = x;
+
+        runLengthTree<keyType, valueType>::update(parent);
+
+        runLengthTree<keyType, valueType>::update(x);
+    }
+
+
+    constexpr void attach(node* x, node* parent, const bool asLeft) noexcept
+    {
+        x->parent = parent;
+
+        ( asLeft ? parent->left : parent->right ) = x;
+
+        runLengthTree<keyType, valueType>::refresh(x);
+
+        while ( x->parent not_eq nullptr and x->parent->priority < x->priority )
+            this->rotateUp(x);
+    }
+
+
+    constexpr void detach(node* x) noexcept
+    {
+        while ( x->left not_eq nullptr and x->right not_eq nullptr )
+            this->rotateUp(x->left->priority > x->right->priority ? x->left : x->right);
+
+        node* child = ( x->left not_eq nullptr ? x->left : x->right );
+
+        node* parent = x->parent;
+
+        if ( child not_eq nullptr )
+            child->parent = parent;
+
+        if ( parent == nullptr )
+            this->m_root = child;
+
+        else if ( parent->left == x )
+            parent->left = child;
+
+        else
+            parent->right = child;
+
+        runLengthTree<keyType, valueType>::refresh(parent);
+    }
+};
+
+
+template<class keyType, class valueType, class innerType = std::map<keyType, valueType>>
+class valueIndexedMap
+{
+    innerType m_map;
+
+    std::unordered_map<valueType, std::set<keyType>> m_index;
+
+    std::unordered_map<valueType, std::size_t> m_lengths;
+
+
+    [[nodiscard]] constexpr typename innerType::iterator mutableIterator(typename innerType::const_iterator position)
+    {
+        return this->m_map.erase(position, position);
+    }
+
+
+    constexpr void indexInsert(const keyType& key, const valueType& value)
+    {
+        this->m_index[value].insert(key);
+    }
+
+
+    constexpr void indexErase(const keyType& key, const valueType& value)
+    {
+        if ( const auto it = this->m_index.find(value); it not_eq this->m_index.end() and it->second.erase(key) and it->second.empty() )
+            this->m_index.erase(it);
+    }
+
+
+    constexpr void addLength(const valueType& value, const std::size_t length)
+    {
+        this->m_lengths[value] += length;
+    }
+
+
+    constexpr void subtractLength(const valueType& value, const std::size_t length)
+    {
+        if ( const auto it = this->m_lengths.find(value); it not_eq this->m_lengths.end() and ( it->second -= length ) == 0 )
+            this->m_lengths.erase(it);
+    }
+
+
+    constexpr void countRun(typename innerType::const_iterator it, const bool add)
+    {
+        if ( it == this->m_map.cend() )
+            return;
+
+        const auto next = std::next(it);
+
+        if ( next == this->m_map.cend() )
+            return;
+
+        if ( add )
+            this->addLength(it->second, ( std::size_t ) ( next->first - it->first ));
+
+        else
+            this->subtractLength(it->second, ( std::size_t ) ( next->first - it->first ));
+    }
+
+
+    [[nodiscard]] constexpr typename innerType::const_iterator previousOf(typename innerType::const_iterator it) const
+    {
+        return ( it == this->m_map.cbegin() ? this->m_map.cend() : std::prev(it) );
+    }
+
+
+    constexpr void countInserted(typename innerType::const_iterator it)
+    {
+        const auto previous = this->previousOf(it);
+
+        const auto next = std::next(it);
+
+        if ( previous not_eq this->m_map.cend() )
+        {
+            if ( next not_eq this->m_map.cend() )
+                this->subtractLength(previous->second, ( std::size_t ) ( next->first - it->first ));
+
+            else
+                this->addLength(previous->second, ( std::size_t ) ( it->first - previous->first ));
+        }
+
+        this->countRun(it, true);
+    }
+
+
+public:
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = typename innerType::const_iterator;
+
+    using const_iterator = typename innerType::const_iterator;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    constexpr valueIndexedMap(): m_map{}, m_index{} {}
+
+
+    constexpr valueIndexedMap(const std::initializer_list<value_type>& list): valueIndexedMap()
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    constexpr valueIndexedMap& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const valueIndexedMap<keyType, valueType, innerType>& other) const
+    {
+        return this->m_map == other.m_map;
+    }
+
+
+    [[nodiscard]] constexpr const_iterator begin(void) const { return this->m_map.cbegin(); }
+
+    [[nodiscard]] constexpr const_iterator end(void) const { return this->m_map.cend(); }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->m_map.cbegin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->m_map.cend(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
+
+
+    [[nodiscard]] constexpr bool empty(void) const noexcept 
+    { 
+        return this->m_map.empty(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t size(void) const noexcept 
+    { 
+        return this->m_map.size(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        std::size_t size { sizeof(this->m_index) + this->m_index.bucket_count() * sizeof(void*) };
+
+        for ( const auto& [value, keys] : this->m_index )
+            size += sizeof(std::pair<const valueType, std::set<keyType>>) + keys.size() * ( sizeof(keyType) + 4 * sizeof(void*) );
+
+        if constexpr ( requires { this->m_map.getByteSize(); } )
+            return size + this->m_map.getByteSize();
+
+        else
+            return size + sizeof(innerType) + sizeof(value_type) * this->m_map.size();
+    }
+
+
+    [[nodiscard]] constexpr const std::set<keyType>* findValueKeys(const valueType& value) const
+    {
+        const auto it = this->m_index.find(value);
+
+        return ( it == this->m_index.cend() ? nullptr : &it->second );
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getDistinctValuesCount(void) const noexcept
+    {
+        return this->m_index.size();
+    }
+
+
+    [[nodiscard]] constexpr const std::unordered_map<valueType, std::size_t>& getValueLengths(void) const noexcept
+    {
+        return this->m_lengths;
+    }
+
+
+    constexpr void clear(void)
+    {
+        this->m_map.clear();
+
+        this->m_index.clear();
+
+        this->m_lengths.clear();
+    }
+
+
+    [[nodiscard]] constexpr const_iterator lower_bound(const keyType& key) const 
+    { 
+        return this->m_map.lower_bound(key); 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator upper_bound(const keyType& key) const 
+    { 
+        return this->m_map.upper_bound(key); 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator find(const keyType& key) const 
+    { 
+        return this->m_map.find(key); 
+    }
+
+
+    constexpr std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        const auto [it, inserted] = this->m_map.emplace(key, value);
+
+        if ( inserted )
+        {
+            this->indexInsert(it->first, it->second);
+
+            this->countInserted(it);
+        }
+
+        return { it, inserted };
+    }
+
+
+    constexpr iterator emplace_hint(const_iterator hint, const keyType& key, const valueType& value)
+    {
+        const auto size = this->m_map.size();
+
+        const iterator it = this->m_map.emplace_hint(hint, key, value);
+
+        if ( this->m_map.size() not_eq size )
+        {
+            this->indexInsert(it->first, it->second);
+
+            this->countInserted(it);
+        }
+
+        return it;
+    }
+
+
+    constexpr iterator erase(const_iterator position)
+    {
+        return this->erase(position, std::next(position));
+    }
+
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        if ( first == last )
+            return this->mutableIterator(first);
+
+        this->countRun(this->previousOf(first), false);
+
+        for ( auto it = first; it not_eq last; ++it )
+        {
+            this->countRun(it, false);
+
+            this->indexErase(it->first, it->second);
+        }
+
+        const iterator result = this->m_map.erase(first, last);
+
+        this->countRun(this->previousOf(result), true);
+
+        return result;
+    }
+
+
+    constexpr void assign(iterator position, const valueType& value)
+    {
+        this->countRun(position, false);
+
+        this->indexErase(position->first, position->second);
+
+        this->indexInsert(position->first, value);
+
+        const auto it = this->mutableIterator(position);
+
+        if constexpr ( requires { this->m_map.assign(it, value); } )
+            this->m_map.assign(it, value);
+
+        else
+            it->second = value;
+
+        this->countRun(position, true);
+    }
+
+
+    [[nodiscard]] constexpr valueType prefixSum(const keyType& key) const requires requires(const innerType& map) { map.prefixSum(key); }
+    {
+        return this->m_map.prefixSum(key);
+    }
+
+
+    [[nodiscard]] constexpr auto rangeMinimum(const keyType& from, const keyType& to) const requires requires(const innerType& map) { map.rangeMinimum(from, to); }
+    {
+        return this->m_map.rangeMinimum(from, to);
+    }
+
+
+    [[nodiscard]] constexpr auto rangeMaximum(const keyType& from, const keyType& to) const requires requires(const innerType& map) { map.rangeMaximum(from, to); }
+    {
+        return this->m_map.rangeMaximum(from, to);
+    }
+
+
+    constexpr iterator shiftKeys(iterator first, iterator last, const keyType& difference)
+    {
+        if ( first == last )
+            return first;
+
+        std::size_t count { 0 };
+
+        this->countRun(this->previousOf(first), false);
+
+        for ( auto it = first; it not_eq last; ++it, ++count )
+        {
+            this->countRun(it, false);
+
+            this->indexErase(it->first, it->second);
+        }
+
+        iterator result = shiftStorageKeys(this->m_map, this->mutableIterator(first), this->mutableIterator(last), difference);
+
+        this->countRun(this->previousOf(result), true);
+
+        auto it = result;
+
+        for ( ; count not_eq 0; ++it, --count )
+        {
+            this->indexInsert(it->first, it->second);
+
+            this->countRun(it, true);
+        }
+
+        return result;
+    }
+};
+
+
+template<class keyType, class valueType>
+using valueIndexedFlatMap = valueIndexedMap<keyType, valueType, flatMap<keyType, valueType>>;
+
+
+template<class keyType, class valueType>
+class sharedChunkMap
+{
+    static constexpr std::size_t chunkCapacity { 512 };
+
+    struct chunk
+    {
+        std::vector<keyType> keys;
+
+        std::vector<valueType> values;
+    };
+
+    struct directory
+    {
+        std::vector<std::shared_ptr<chunk>> chunks;
+
+        std::vector<keyType> firstKeys;
+
+        std::size_t size { 0 };
+    };
+
+    std::shared_ptr<directory> m_directory;
+
+
+    class iteratorType
+    {
+        friend class sharedChunkMap<keyType, valueType>;
+
+        const sharedChunkMap<keyType, valueType>* m_owner;
+
+        std::size_t m_chunk, m_index;
+
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using value_type = std::pair<keyType, valueType>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = std::pair<const keyType&, const valueType&>;
+
+        struct pointer
+        {
+            reference ref;
+
+            constexpr const reference* operator->(void) const noexcept { return &this->ref; }
+        };
+
+
+        constexpr iteratorType(): m_owner{ nullptr }, m_chunk{ 0 }, m_index{ 0 } {}
+
+
+        constexpr iteratorType(const sharedChunkMap<keyType, valueType>* owner, std::size_t chunk, std::size_t index): m_owner{ owner }, m_chunk{ chunk }, m_index{ index } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const 
+        { 
+            const auto& current = *this->m_owner->m_directory->chunks[this->m_chunk];
+
+            return { current.keys[this->m_index], current.values[this->m_index] }; 
+        }
+
+
+        [[nodiscard]] constexpr pointer operator->(void) const 
+        { 
+            return { **this }; 
+        }
+
+
+        constexpr iteratorType& operator++(void) 
+        { 
+            if ( ++this->m_index == this->m_owner->m_directory->chunks[this->m_chunk]->keys.size() )
+            {
+                ++this->m_chunk;
+
+                this->m_index = 0;
+            }
+
+            return *this; 
+        }
+
+
+        constexpr iteratorType& operator--(void) 
+        { 
+            if ( this->m_index == 0 )
+                this->m_index = this->m_owner->m_directory->chunks[--this->m_chunk]->keys.size();
+
+            --this->m_index;
+
+            return *this; 
+        }
+
+
+        constexpr iteratorType operator++(int) { auto temp = *this; ++*this; return temp; }
+
+        constexpr iteratorType operator--(int) { auto temp = *this; --*this; return temp; }
+
+
+        [[nodiscard]] constexpr bool operator==(const iteratorType& other) const noexcept 
+        { 
+            return this->m_chunk == other.m_chunk and this->m_index == other.m_index; 
+        }
+    };
+
+
+    [[nodiscard]] constexpr iteratorType makeIterator(std::size_t chunk, std::size_t index) const
+    {
+        const auto& chunks = this->m_directory->chunks;
+
+        if ( chunk not_eq chunks.size() and index == chunks[chunk]->keys.size() )
+        {
+            ++chunk;
+
+            index = 0;
+        }
+
+        return { this, chunk, index };
+    }
+
+
+    [[nodiscard]] constexpr std::size_t chunkOf(const keyType& key) const
+    {
+        const auto& firstKeys = this->m_directory->firstKeys;
+
+        const auto it = std::upper_bound(firstKeys.cbegin(), firstKeys.cend(), key);
+
+        return ( it == firstKeys.cbegin() ? 0 : ( std::size_t ) std::distance(firstKeys.cbegin(), it) - 1 );
+    }
+
+
+    template<bool upper>
+    [[nodiscard]] constexpr iteratorType bound(const keyType& key) const
+    {
+        if ( this->m_directory->size == 0 )
+            return this->end();
+
+        const std::size_t chunkIndex { this->chunkOf(key) };
+
+        const auto& keys = this->m_directory->chunks[chunkIndex]->keys;
+
+        const auto it = ( upper ? std::upper_bound(keys.cbegin(), keys.cend(), key) : std::lower_bound(keys.cbegin(), keys.cend(), key) );
+
+        return this->makeIterator(chunkIndex, ( std::size_t ) std::distance(keys.cbegin(), it));
+    }
+
+
+    constexpr directory& uniqueDirectory(void)
+    {
+        if ( this->m_directory.use_count() > 1 )
+            this->m_directory = std::make_shared<directory>(*this->m_directory);
+
+        return *this->m_directory;
+    }
+
+
+    constexpr chunk& uniqueChunk(const std::size_t chunkIndex)
+    {
+        auto& pointer = this->uniqueDirectory().chunks[chunkIndex];
+
+        if ( pointer.use_count() > 1 )
+            pointer = std::make_shared<chunk>(*pointer);
+
+        return *pointer;
+    }
+
+
+    constexpr void removeChunk(const std::size_t chunkIndex)
+    {
+        auto& current = this->uniqueDirectory();
+
+        current.chunks.erase(current.chunks.begin() + ( std::ptrdiff_t ) chunkIndex);
+
+        current.firstKeys.erase(current.firstKeys.begin() + ( std::ptrdiff_t ) chunkIndex);
+    }
+
+
+    constexpr iteratorType insertAt(const std::size_t chunkIndex, const std::size_t index, const keyType& key, const valueType& value)
+    {
+        auto& current = this->uniqueChunk(chunkIndex);
+
+        current.keys.insert(current.keys.cbegin() + ( std::ptrdiff_t ) index, key);
+
+        current.values.insert(current.values.cbegin() + ( std::ptrdiff_t ) index, value);
+
+        auto& owner = *this->m_directory;
+
+        ++owner.size;
+
+        if ( index == 0 )
+            owner.firstKeys[chunkIndex] = key;
+
+        if ( current.keys.size() <= chunkCapacity )
+            return { this, chunkIndex, index };
+
+        const std::size_t half { current.keys.size() / 2 };
+
+        auto tail = std::make_shared<chunk>();
+
+        tail->keys.assign(current.keys.cbegin() + ( std::ptrdiff_t ) half, current.keys.cend());
+
+        tail->values.assign(current.values.cbegin() + ( std::ptrdiff_t ) half, current.values.cend());
+
+        current.keys.resize(half);
+
+        current.values.resize(half);
+
+        owner.firstKeys.insert(owner.firstKeys.cbegin() + ( std::ptrdiff_t ) chunkIndex + 1, tail->keys.front());
+
+        owner.chunks.insert(owner.chunks.cbegin() + ( std::ptrdiff_t ) chunkIndex + 1, std::move(tail));
+
+        return ( index < half ? iteratorType{ this, chunkIndex, index } : iteratorType{ this, chunkIndex + 1, index - half } );
+    }
+
+
+public:
+
+    static constexpr bool isCopyOnWrite { true };
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = iteratorType;
+
+    using const_iterator = iteratorType;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    constexpr sharedChunkMap(): m_directory{ std::make_shared<directory>() } {}
+
+
+    constexpr sharedChunkMap(const std::initializer_list<value_type>& list): sharedChunkMap()
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    constexpr sharedChunkMap& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const sharedChunkMap<keyType, valueType>& other) const
+    {
+        return this->m_directory == other.m_directory or std::equal(this->cbegin(), this->cend(), other.cbegin(), other.cend(), 
+            [](const auto& a, const auto& b) { return a.first == b.first and a.second == b.second; });
+    }
+
+
+    [[nodiscard]] constexpr const_iterator begin(void) const { return { this, 0, 0 }; }
+
+    [[nodiscard]] constexpr const_iterator end(void) const { return { this, this->m_directory->chunks.size(), 0 }; }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->begin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->end(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
+
+
+    [[nodiscard]] constexpr bool empty(void) const noexcept 
+    { 
+        return this->m_directory->size == 0; 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t size(void) const noexcept 
+    { 
+        return this->m_directory->size; 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        const auto& current = *this->m_directory;
+
+        std::size_t size { sizeof(directory) + current.chunks.capacity() * sizeof(std::shared_ptr<chunk>) + current.firstKeys.capacity() * sizeof(keyType) };
+
+        for ( const auto& pointer : current.chunks )
+            size += ( sizeof(chunk) + pointer->keys.capacity() * sizeof(keyType) + pointer->values.capacity() * sizeof(valueType) ) / ( std::size_t ) pointer.use_count();
+
+        return sizeof(m_directory) + size / ( std::size_t ) this->m_directory.use_count();
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getSharedChunksCount(void) const noexcept
+    {
+        return ( std::size_t ) std::count_if(this->m_directory->chunks.cbegin(), this->m_directory->chunks.cend(), 
+            [this](const auto& pointer) { return this->m_directory.use_count() > 1 or pointer.use_count() > 1; });
+    }
+
+
+    constexpr void clear(void)
+    {
+        this->m_directory = std::make_shared<directory>();
+    }
+
+
+    [[nodiscard]] constexpr const_iterator lower_bound(const keyType& key) const 
+    { 
+        return this->bound<false>(key); 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator upper_bound(const keyType& key) const 
+    { 
+        return this->bound<true>(key); 
+    }
+
+
+    [[nodiscard]] constexpr const_iterator find(const keyType& key) const
+    {
+        const auto it = this->lower_bound(key);
+
+        return ( it not_eq this->end() and it->first == key ? it : this->end() );
+    }
+
+
+    constexpr std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        if ( this->empty() )
+        {
+            auto& current = this->uniqueDirectory();
+
+            current.chunks.push_back(std::make_shared<chunk>(chunk{ { key }, { value } }));
+
+            current.firstKeys.push_back(key);
+
+            current.size = 1;
+
+            return { this->begin(), true };
+        }
+
+        const auto it = this->lower_bound(key);
+
+        if ( it not_eq this->end() and it->first == key )
+            return { it, false };
+
+        return { this->emplace_hint(it, key, value), true };
+    }
+
+
+    constexpr iterator emplace_hint(const_iterator hint, const keyType& key, const valueType& value)
+    {
+        if ( hint not_eq this->end() and hint->first == key )
+            return hint;
+
+        if ( this->empty() or ( hint not_eq this->end() and hint->first < key ) or ( hint not_eq this->begin() and not ( std::prev(hint)->first < key ) ) )
+            return this->emplace(key, value).first;
+
+        if ( hint.m_index == 0 and hint.m_chunk not_eq 0 )
+            return this->insertAt(hint.m_chunk - 1, this->m_directory->chunks[hint.m_chunk - 1]->keys.size(), key, value);
+
+        return this->insertAt(hint.m_chunk, hint.m_index, key, value);
+    }
+
+
+    constexpr iterator erase(const_iterator position)
+    {
+        return this->erase(position, std::next(position));
+    }
+
+
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        if ( first == last )
+            return first;
+
+        std::size_t firstChunk { first.m_chunk };
+
+        if ( firstChunk == last.m_chunk )
+        {
+            auto& current = this->uniqueChunk(firstChunk);
+
+            current.keys.erase(current.keys.cbegin() + ( std::ptrdiff_t ) first.m_index, current.keys.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+            current.values.erase(current.values.cbegin() + ( std::ptrdiff_t ) first.m_index, current.values.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+            this->m_directory->size -= last.m_index - first.m_index;
+
+            if ( current.keys.empty() )
+            {
+                this->removeChunk(firstChunk);
+
+                return { this, firstChunk, 0 };
+            }
+
+            this->m_directory->firstKeys[firstChunk] = current.keys.front();
+
+            return this->makeIterator(firstChunk, first.m_index);
+        }
+
+        auto& owner = this->uniqueDirectory();
+
+        if ( last.m_chunk not_eq owner.chunks.size() and last.m_index not_eq 0 )
+        {
+            auto& current = this->uniqueChunk(last.m_chunk);
+
+            current.keys.erase(current.keys.cbegin(), current.keys.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+            current.values.erase(current.values.cbegin(), current.values.cbegin() + ( std::ptrdiff_t ) last.m_index);
+
+            owner.firstKeys[last.m_chunk] = current.keys.front();
+
+            owner.size -= last.m_index;
+        }
+
+        for ( std::size_t chunkIndex = firstChunk + 1; chunkIndex < last.m_chunk; ++chunkIndex )
+            owner.size -= owner.chunks[chunkIndex]->keys.size();
+
+        owner.chunks.erase(owner.chunks.cbegin() + ( std::ptrdiff_t ) firstChunk + 1, owner.chunks.cbegin() + ( std::ptrdiff_t ) last.m_chunk);
+
+        owner.firstKeys.erase(owner.firstKeys.cbegin() + ( std::ptrdiff_t ) firstChunk + 1, owner.firstKeys.cbegin() + ( std::ptrdiff_t ) last.m_chunk);
+
+        if ( first.m_index == 0 )
+        {
+            owner.size -= owner.chunks[firstChunk]->keys.size();
+
+            this->removeChunk(firstChunk);
+
+            return { this, firstChunk, 0 };
+        }
+
+        auto& current = this->uniqueChunk(firstChunk);
+
+        owner.size -= current.keys.size() - first.m_index;
+
+        current.keys.resize(first.m_index);
+
+        current.values.resize(first.m_index);
+
+        return { this, firstChunk + 1, 0 };
+    }
+
+
+    constexpr void assign(iterator position, const valueType& value)
+    {
+        this->uniqueChunk(position.m_chunk).values[position.m_index] = value;
+    }
+
+
+    constexpr iterator shiftKeys(iterator first, iterator last, const keyType& difference)
+    {
+        for ( auto position = first; position not_eq last; )
+        {
+            auto& current = this->uniqueChunk(position.m_chunk);
+
+            const std::size_t endIndex { position.m_chunk == last.m_chunk ? last.m_index : current.keys.size() };
+
+            std::for_each(current.keys.begin() + ( std::ptrdiff_t ) position.m_index, current.keys.begin() + ( std::ptrdiff_t ) endIndex, 
+                [&difference](keyType& key) { key += difference; });
+
+            this->m_directory->firstKeys[position.m_chunk] = current.keys.front();
+
+            position = this->makeIterator(position.m_chunk, endIndex);
+        }
+
+        return first;
+    }
+};
+
+
+template<class keyType, class valueType>
+class seqlockFlatMap
+{
+    static_assert(std::is_trivially_copyable_v<keyType> and std::is_trivially_copyable_v<valueType>, "seqlockFlatMap readers may observe torn entries, so keys and values must be trivially copyable.");
+
+    static_assert(alignof(keyType) >= std::atomic_ref<keyType>::required_alignment and alignof(valueType) >= std::atomic_ref<valueType>::required_alignment, 
+        "seqlockFlatMap entries are accessed through std::atomic_ref, so they must be suitably aligned.");
+
+    struct block
+    {
+        std::size_t capacity { 0 };
+
+        std::atomic<std::size_t> size { 0 };
+
+        std::unique_ptr<keyType[]> keys;
+
+        std::unique_ptr<valueType[]> values;
+    };
+
+    std::vector<std::unique_ptr<block>> m_blocks;
+
+    std::atomic<block*> m_current;
+
+
+    class iteratorType
+    {
+        friend class seqlockFlatMap<keyType, valueType>;
+
+        const seqlockFlatMap<keyType, valueType>* m_owner;
+
+        std::size_t m_index;
+
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+
+        using value_type = std::pair<keyType, valueType>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = std::pair<const keyType&, const valueType&>;
+
+        struct pointer
+        {
+            reference ref;
+
+            constexpr const reference* operator->(void) const noexcept { return &this->ref; }
+        };
+
+
+        constexpr iteratorType(): m_owner{ nullptr }, m_index{ 0 } {}
+
+
+        constexpr iteratorType(const seqlockFlatMap<keyType, valueType>* owner, std::size_t index): m_owner{ owner }, m_index{ index } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const 
+        { 
+            const block& current = this->m_owner->currentBlock();
+
+            return { current.keys[this->m_index], current.values[this->m_index] }; 
+        }
+
+
+        [[nodiscard]] constexpr pointer operator->(void) const { return { **this }; }
+
+        [[nodiscard]] constexpr reference operator[](const difference_type offset) const { return *(*this + offset); }
+
+        constexpr iteratorType& operator++(void) noexcept { ++this->m_index; return *this; }
+
+        constexpr iteratorType& operator--(void) noexcept { --this->m_index; return *this; }
+
+        constexpr iteratorType operator++(int) noexcept { auto temp = *this; ++this->m_index; return temp; }
+
+        constexpr iteratorType operator--(int) noexcept { auto temp = *this; --this->m_index; return temp; }
+
+        constexpr iteratorType& operator+=(const difference_type offset) noexcept { this->m_index += offset; return *this; }
+
+        constexpr iteratorType& operator-=(const difference_type offset) noexcept { this->m_index -= offset; return *this; }
+
+        [[nodiscard]] constexpr iteratorType operator+(const difference_type offset) const noexcept { return { this->m_owner, this->m_index + offset }; }
+
+        [[nodiscard]] constexpr iteratorType operator-(const difference_type offset) const noexcept { return { this->m_owner, this->m_index - offset }; }
+
+        [[nodiscard]] friend constexpr iteratorType operator+(const difference_type offset, const iteratorType& it) noexcept { return it + offset; }
+
+        [[nodiscard]] constexpr difference_type operator-(const iteratorType& other) const noexcept { return ( difference_type ) this->m_index - ( difference_type ) other.m_index; }
+
+        [[nodiscard]] constexpr bool operator==(const iteratorType& other) const noexcept { return this->m_index == other.m_index; }
+
+        [[nodiscard]] constexpr auto operator<=>(const iteratorType& other) const noexcept { return this->m_index <=> other.m_index; }
+    };
+
+
+    // Entries of the published block may be read by optimistic readers at any time, so every store to them is a relaxed atomic store.
+    template<class T>
+    static void storeRelaxed(T& target, const T& value) noexcept
+    {
+        std::atomic_ref<T>{ target }.store(value, std::memory_order_relaxed);
+    }
+
+
+    template<class T>
+    static void copyRelaxed(const T* first, const T* last, T* output) noexcept
+    {
+        for ( ; first not_eq last ; ++first, ++output )
+            storeRelaxed(*output, *first);
+    }
+
+
+    template<class T>
+    static void copyBackwardRelaxed(const T* first, const T* last, T* outputLast) noexcept
+    {
+        while ( last not_eq first )
+            storeRelaxed(*--outputLast, *--last);
+    }
+
+
+    [[nodiscard]] const block& currentBlock(void) const noexcept
+    {
+        return *this->m_current.load(std::memory_order_acquire);
+    }
+
+
+    [[nodiscard]] block& writableBlock(const std::size_t size)
+    {
+        block& current = *this->m_current.load(std::memory_order_relaxed);
+
+        if ( size <= current.capacity )
+            return current;
+
+        auto next = std::make_unique<block>();
+
+        next->capacity = std::max({ size, 2 * current.capacity, std::size_t(16) });
+
+        next->keys = std::make_unique_for_overwrite<keyType[]>(next->capacity);
+
+        next->values = std::make_unique_for_overwrite<valueType[]>(next->capacity);
+
+        const std::size_t currentSize { current.size.load(std::memory_order_relaxed) };
+
+        std::copy_n(current.keys.get(), currentSize, next->keys.get());
+
+        std::copy_n(current.values.get(), currentSize, next->values.get());
+
+        next->size.store(currentSize, std::memory_order_relaxed);
+
+        this->m_current.store(next.get(), std::memory_order_release);
+
+        this->m_blocks.push_back(std::move(next));
+
+        return *this->m_blocks.back();
+    }
+
+
+    [[nodiscard]] std::size_t lowerBoundIndex(const keyType& key) const
+    {
+        const block& current = this->currentBlock();
+
+        return ( std::size_t ) ( std::lower_bound(current.keys.get(), current.keys.get() + current.size.load(std::memory_order_relaxed), key) - current.keys.get() );
+    }
+
+
+    [[nodiscard]] std::size_t upperBoundIndex(const keyType& key) const
+    {
+        const block& current = this->currentBlock();
+
+        return ( std::size_t ) ( std::upper_bound(current.keys.get(), current.keys.get() + current.size.load(std::memory_order_relaxed), key) - current.keys.get() );
+    }
+
+
+    void assignFrom(const seqlockFlatMap<keyType, valueType>& other)
+    {
+        const block& source = other.currentBlock();
+
+        const std::size_t size { source.size.load(std::memory_order_relaxed) };
+
+        block& target = this->writableBlock(size);
+
+        copyRelaxed(source.keys.get(), source.keys.get() + size, target.keys.get());
+
+        copyRelaxed(source.values.get(), source.values.get() + size, target.values.get());
+
+        target.size.store(size, std::memory_order_release);
+    }
+
+public:
+
+    using key_type = keyType;
+
+    using mapped_type = valueType;
+
+    using value_type = std::pair<const keyType, valueType>;
+
+    using size_type = std::size_t;
+
+    using iterator = iteratorType;
+
+    using const_iterator = iteratorType;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    seqlockFlatMap(): m_blocks{}, m_current{ nullptr }
+    {
+        this->m_blocks.push_back(std::make_unique<block>());
+
+        this->m_current.store(this->m_blocks.back().get(), std::memory_order_release);
+    }
+
+
+    seqlockFlatMap(const std::initializer_list<value_type>& list): seqlockFlatMap()
+    {
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+    }
+
+
+    seqlockFlatMap(const seqlockFlatMap<keyType, valueType>& other): seqlockFlatMap()
+    {
+        this->assignFrom(other);
+    }
+
+
+    seqlockFlatMap<keyType, valueType>& operator=(const seqlockFlatMap<keyType, valueType>& other)
+    {
+        if ( this not_eq &other )
+            this->assignFrom(other);
+
+        return *this;
+    }
+
+
+    seqlockFlatMap<keyType, valueType>& operator=(const std::initializer_list<value_type>& list)
+    {
+        this->clear();
+
+        for ( const auto& [key, value] : list )
+            this->emplace(key, value);
+
+        return *this;
+    }
+
+
+    [[nodiscard]] bool operator==(const seqlockFlatMap<keyType, valueType>& other) const
+    {
+        const auto keys = this->getKeys(), otherKeys = other.getKeys();
+
+        const auto values = this->getValues(), otherValues = other.getValues();
+
+        return std::equal(keys.begin(), keys.end(), otherKeys.begin(), otherKeys.end()) and std::equal(values.begin(), values.end(), otherValues.begin(), otherValues.end());
+    }
+
+
+    [[nodiscard]] const_iterator begin(void) const noexcept { return { this, 0 }; }
+
+    [[nodiscard]] const_iterator end(void) const noexcept { return { this, this->size() }; }
+
+    [[nodiscard]] const_iterator cbegin(void) const noexcept { return this->begin(); }
+
+    [[nodiscard]] const_iterator cend(void) const noexcept { return this->end(); }
+
+    [[nodiscard]] const_reverse_iterator rbegin(void) const noexcept { return const_reverse_iterator(this->end()); }
+
+    [[nodiscard]] const_reverse_iterator rend(void) const noexcept { return const_reverse_iterator(this->begin()); }
+
+    [[nodiscard]] const_reverse_iterator crbegin(void) const noexcept { return this->rbegin(); }
+
+    [[nodiscard]] const_reverse_iterator crend(void) const noexcept { return this->rend(); }
+
+
+    [[nodiscard]] bool empty(void) const noexcept 
+    { 
+        return this->size() == 0; 
+    }
+
+
+    [[nodiscard]] std::size_t size(void) const noexcept 
+    { 
+        return this->currentBlock().size.load(std::memory_order_acquire); 
+    }
+
+
+    [[nodiscard]] std::size_t getByteSize(void) const noexcept
+    {
+        std::size_t size { sizeof(seqlockFlatMap<keyType, valueType>) + this->m_blocks.capacity() * sizeof(std::unique_ptr<block>) };
+
+        for ( const auto& current : this->m_blocks )
+            size += sizeof(block) + current->capacity * ( sizeof(keyType) + sizeof(valueType) );
+
+        return size;
+    }
+
+
+    [[nodiscard]] std::span<const keyType> getKeys(void) const noexcept 
+    { 
+        const block& current = this->currentBlock();
+
+        return { current.keys.get(), current.size.load(std::memory_order_acquire) }; 
+    }
+
+
+    [[nodiscard]] std::span<const valueType> getValues(void) const noexcept 
+    { 
+        const block& current = this->currentBlock();
+
+        return { current.values.get(), current.size.load(std::memory_order_acquire) }; 
+    }
+
+
+    template<class functionType>
+    decltype(auto) readSnapshot(functionType&& function) const
+    {
+        const block& current = this->currentBlock();
+
+        const std::size_t size { std::min(current.size.load(std::memory_order_acquire), current.capacity) };
+
+        return std::forward<functionType>(function)(std::span<const keyType>{ current.keys.get(), size }, std::span<const valueType>{ current.values.get(), size });
+    }
+
+
+    void clear(void) noexcept
+    {
+        this->m_current.load(std::memory_order_relaxed)->size.store(0, std::memory_order_release);
+    }
+
+
+    [[nodiscard]] const_iterator lower_bound(const keyType& key) const { return { this, this->lowerBoundIndex(key) }; }
+
+    [[nodiscard]] const_iterator upper_bound(const keyType& key) const { return { this, this->upperBoundIndex(key) }; }
+
+
+    [[nodiscard]] const_iterator find(const keyType& key) const
+    {
+        const std::size_t index { this->lowerBoundIndex(key) };
+
+        return ( index not_eq this->size() and this->currentBlock().keys[index] == key ? const_iterator{ this, index } : this->end() );
+    }
+
+
+    std::pair<iterator, bool> emplace(const keyType& key, const valueType& value)
+    {
+        const std::size_t index { this->lowerBoundIndex(key) };
+
+        if ( index not_eq this->size() and this->currentBlock().keys[index] == key )
+            return { { this, index }, false };
+
+        return { this->insertAt(index, key, value), true };
+    }
+
+
+    iterator emplace_hint(const_iterator hint, const keyType& key, const valueType& value)
+    {
+        const std::size_t size { this->size() };
+
+        const block& current = this->currentBlock();
+
+        std::size_t index { hint.m_index };
+
+        if ( ( index not_eq size and current.keys[index] < key ) or ( index not_eq 0 and key < current.keys[index - 1] ) )
+            index = this->lowerBoundIndex(key);
+
+        if ( index not_eq size and current.keys[index] == key )
+            return { this, index };
+
+        return this->insertAt(index, key, value);
+    }
+
+
+    iterator insertAt(const std::size_t index, const keyType& key, const valueType& value)
+    {
+        const std::size_t size { this->size() };
+
+        block& current = this->writableBlock(size + 1);
+
+        copyBackwardRelaxed(current.keys.get() + index, current.keys.get() + size, current.keys.get() + size + 1);
+
+        copyBackwardRelaxed(current.values.get() + index, current.values.get() + size, current.values.get() + size + 1);
+
+        storeRelaxed(current.keys[index], key);
+
+        storeRelaxed(current.values[index], value);
+
+        current.size.store(size + 1, std::memory_order_release);
+
+        return { this, index };
+    }
+
+
+    iterator erase(const_iterator position)
+    {
+        return this->erase(position, position + 1);
+    }
+
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        block& current = *this->m_current.load(std::memory_order_relaxed);
+
+        const std::size_t size { current.size.load(std::memory_order_relaxed) };
+
+        copyRelaxed(current.keys.get() + last.m_index, current.keys.get() + size, current.keys.get() + first.m_index);
+
+        copyRelaxed(current.values.get() + last.m_index, current.values.get() + size, current.values.get() + first.m_index);
+
+        current.size.store(size - ( last.m_index - first.m_index ), std::memory_order_release);
+
+        return { this, first.m_index };
+    }
+
+
+    void assign(iterator position, const valueType& value)
+    {
+        storeRelaxed(this->m_current.load(std::memory_order_relaxed)->values[position.m_index], value);
+    }
+
+
+    iterator shiftKeys(iterator first, iterator last, const keyType& difference)
+    {
+        keyType* const keys { this->m_current.load(std::memory_order_relaxed)->keys.get() };
+
+        std::for_each(keys + first.m_index, keys + last.m_index, [&difference](keyType& key) { storeRelaxed(key, key + difference); });
+
+        return first;
+    }
+};
+
+
+template<class vectorType>
+class compressedVectorTerminal;
+
+
+template<class vectorType>
+class compressedVectorView;
+
+
+template<class vectorType>
+class seqlockCompressedVector;
+
+
+template <BigInteger keyType = uint64_t, class valueType = int64_t, bool arithmeticSafe = false, bool threadSafe = false, template<class...> class storageType = std::map>
+class compressedVector : compressedVectorBase<threadSafe>
+{
+    template<class vectorType>
+    friend class compressedVectorTerminal;
+
+    template<class vectorType>
+    friend class seqlockCompressedVector;
+
+    keyType minIndex, maxIndex;
+
+    valueType m_valBegin;
+
+    storageType<keyType, valueType> m_map;
+
+    using mapIterator = typename storageType<keyType, valueType>::const_iterator;
+
+
+    class runIterator;
+
+
+    class elementIterator
+    {
+        friend class compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>;
+
+        friend class runIterator;
+
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>* m_owner;
+
+        mapIterator m_next;
+
+        keyType m_from, m_to, m_index, m_runBegin, m_runEnd;
+
+        const valueType* m_value;
+
+
+        constexpr elementIterator(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>* owner, const keyType& from, const keyType& to, const keyType& index):
+            m_owner{ owner }, m_next{ owner->m_map.cend() }, m_from{ from }, m_to{ to }, m_index{ from }, m_runBegin{ from }, m_runEnd{ from }, m_value{ &owner->m_valBegin }
+        {
+            if ( from not_eq to )
+                this->moveTo(index);
+        }
+
+
+        constexpr void seek(const keyType& key)
+        {
+            const auto& map = this->m_owner->m_map;
+
+            this->m_next = map.upper_bound(key);
+
+            if ( this->m_next == map.cbegin() )
+            {
+                this->m_value = &this->m_owner->m_valBegin;
+
+                this->m_runBegin = this->m_from;
+            }
+            else
+            {
+                const auto previous = std::prev(this->m_next);
+
+                this->m_value = &previous->second;
+
+                this->m_runBegin = std::max(previous->first, this->m_from);
+            }
+
+            this->m_runEnd = ( this->m_next == map.cend() ? this->m_to : std::min(this->m_next->first, this->m_to) );
+        }
+
+
+        constexpr void moveTo(const keyType& index)
+        {
+            if ( this->m_runBegin > index or ( index >= this->m_runEnd and ( index not_eq this->m_to or this->m_runEnd not_eq this->m_to ) ) )
+                this->seek(index == this->m_to ? this->m_to - keyType(1) : index);
+
+            this->m_index = index;
+        }
+
+
+        constexpr void nextRun(void)
+        {
+            this->m_index = this->m_runBegin = this->m_runEnd;
+
+            if ( this->m_runEnd == this->m_to )
+                return;
+
+            this->m_value = &this->m_next->second;
+
+            ++this->m_next;
+
+            this->m_runEnd = ( this->m_next == this->m_owner->m_map.cend() ? this->m_to : std::min(this->m_next->first, this->m_to) );
+        }
+
+
+        constexpr void previousRun(void)
+        {
+            --this->m_next;
+
+            this->m_runEnd = this->m_runBegin;
+
+            if ( this->m_next == this->m_owner->m_map.cbegin() )
+            {
+                this->m_value = &this->m_owner->m_valBegin;
+
+                this->m_runBegin = this->m_from;
+            }
+            else
+            {
+                const auto previous = std::prev(this->m_next);
+
+                this->m_value = &previous->second;
+
+                this->m_runBegin = std::max(previous->first, this->m_from);
+            }
+
+            this->m_index = this->m_runEnd - keyType(1);
+        }
+
+
+    public:
+
+        using iterator_concept = std::random_access_iterator_tag;
+
+        using iterator_category = std::random_access_iterator_tag;
+
+        using value_type = valueType;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = const valueType*;
+
+        using reference = const valueType&;
+
+
+        constexpr elementIterator(): m_owner{ nullptr }, m_next{}, m_from{ 0 }, m_to{ 0 }, m_index{ 0 }, m_runBegin{ 0 }, m_runEnd{ 0 }, m_value{ nullptr } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const noexcept { return *this->m_value; }
+
+        [[nodiscard]] constexpr pointer operator->(void) const noexcept { return this->m_value; }
+
+        [[nodiscard]] constexpr reference operator[](const difference_type offset) const { return *(*this + offset); }
+
+
+        [[nodiscard]] constexpr keyType getIndex(void) const noexcept { return this->m_index; }
+
+        [[nodiscard]] constexpr keyType getRunBegin(void) const noexcept { return this->m_runBegin; }
+
+        [[nodiscard]] constexpr keyType getRunEnd(void) const noexcept { return this->m_runEnd; }
+
+
+        constexpr elementIterator& operator++(void)
+        {
+            if ( ++this->m_index == this->m_runEnd and this->m_runEnd not_eq this->m_to )
+                this->nextRun();
+
+            return *this;
+        }
+
+
+        constexpr elementIterator& operator--(void)
+        {
+            if ( this->m_index == this->m_runBegin )
+                this->previousRun();
+
+            else
+                --this->m_index;
+
+            return *this;
+        }
+
+
+        constexpr elementIterator operator++(int) { auto temp = *this; ++*this; return temp; }
+
+        constexpr elementIterator operator--(int) { auto temp = *this; --*this; return temp; }
+
+        constexpr elementIterator& operator+=(const difference_type offset) { this->moveTo(this->m_index + ( keyType ) offset); return *this; }
+
+        constexpr elementIterator& operator-=(const difference_type offset) { this->moveTo(this->m_index - ( keyType ) offset); return *this; }
+
+        [[nodiscard]] constexpr elementIterator operator+(const difference_type offset) const { auto temp = *this; return temp += offset; }
+
+        [[nodiscard]] constexpr elementIterator operator-(const difference_type offset) const { auto temp = *this; return temp -= offset; }
+
+        [[nodiscard]] friend constexpr elementIterator operator+(const difference_type offset, const elementIterator& it) { return it + offset; }
+
+
+        [[nodiscard]] constexpr difference_type operator-(const elementIterator& other) const noexcept 
+        { 
+            return ( difference_type ) this->m_index - ( difference_type ) other.m_index; 
+        }
+
+
+        [[nodiscard]] constexpr bool operator==(const elementIterator& other) const noexcept 
+        { 
+            return this->m_index == other.m_index; 
+        }
+
+
+        [[nodiscard]] constexpr auto operator<=>(const elementIterator& other) const noexcept 
+        { 
+            return this->m_index <=> other.m_index; 
+        }
+    };
+
+
+    class runIterator
+    {
+        elementIterator m_position;
+
+    public:
+
+        using iterator_concept = std::forward_iterator_tag;
+
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = std::tuple<keyType, keyType, const valueType&>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = value_type;
+
+
+        constexpr runIterator() = default;
+
+
+        constexpr explicit runIterator(const elementIterator& position): m_position{ position } {}
+
+
+        [[nodiscard]] constexpr reference operator*(void) const noexcept 
+        { 
+            return { this->m_position.m_runBegin, this->m_position.m_runEnd, *this->m_position.m_value }; 
+        }
+
+
+        constexpr runIterator& operator++(void) { this->m_position.nextRun(); return *this; }
+
+        constexpr runIterator operator++(int) { auto temp = *this; this->m_position.nextRun(); return temp; }
+
+
+        [[nodiscard]] constexpr bool operator==(const runIterator& other) const noexcept 
+        { 
+            return this->m_position == other.m_position; 
+        }
+
+
+        [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept 
+        { 
+            return this->m_position.m_runBegin == this->m_position.m_to; 
+        }
+    };
+
+
+
+
+    constexpr compressedVector(const keyType& maxArg, const storageType<keyType, valueType>& mapArg):
+        minIndex{ mapArg.empty() ? maxArg - keyType(1) : mapArg.cbegin()->first }, maxIndex{ maxArg }, 
+        m_valBegin{ mapArg.empty() ? valueType(0) : mapArg.crbegin()->second }, m_map{ mapArg } 
+        {
+            if ( not this->mapCanonicalValidationDebug() )
+                this->reset(valueType(0));
+        }
+
+
+    /*constexpr compressedVector(const std::initializer_list<std::pair<const keyType, valueType>>& list):
+        //compressedVector(std::empty(list) ? keyType(0) : std::min(list).first, std::empty(list) ? valueType(0) : std::crbegin(list)->second, list){}
+        minIndex{ std::empty(list) ? keyType(0) : std::min(list).first }, maxIndex{ std::numeric_limits<keyType>::max() },
+        m_valBegin{ std::empty(list) ? valueType(0) : std::crbegin(list)->second }, m_map{ list } {}*/
+
+
+    const auto& getMapRef(void) const noexcept { return this->m_map; }
+
+
+    constexpr auto shiftMapKeys
+    (
+        typename storageType<keyType, valueType>::iterator first, 
+        typename storageType<keyType, valueType>::iterator last, 
+        const keyType& difference
+    )
+    {
+        return shiftStorageKeys(this->m_map, first, last, difference);
+    }
+
+
+    constexpr void setMapValue(typename storageType<keyType, valueType>::iterator it, const valueType& value)
+    {
+        if constexpr ( requires { this->m_map.assign(it, value); } )
+            this->m_map.assign(it, value);
+
+        else
+            it->second = value;
+    }
+
+
+    constexpr auto splitMapAt(const keyType& key)
+    {
+        auto it = this->m_map.lower_bound(key);
+
+        if ( it == this->m_map.end() or it->first not_eq key )
+        {
+            const valueType value = ( it == this->m_map.begin() ? this->m_valBegin : std::prev(it)->second );
+
+            it = this->m_map.emplace_hint(it, key, value);
+        }
+
+        return it;
+    }
+
+
+    constexpr void appendRunRange(std::vector<std::pair<keyType, keyType>>& ranges, typename storageType<keyType, valueType>::const_iterator it) const
+    {
+        const keyType begin { std::max(it->first, this->minIndex) };
+
+        const keyType end { ++it == this->m_map.cend() ? this->maxIndex : std::min(it->first, this->maxIndex) };
+
+        if ( begin < end )
+            ranges.emplace_back(begin, end);
+    }
+
+
+    static constexpr void appendCanonicalNode
+    (
+        std::vector<std::pair<keyType, valueType>>& nodes, 
+        const keyType& key, 
+        const valueType& value, 
+        const valueType& initValue
+    )
+    {
+        if ( not nodes.empty() and nodes.back().first == key )
+            nodes.pop_back();
+
+        if ( value not_eq ( nodes.empty() ? initValue : nodes.back().second ) )
+            nodes.emplace_back(key, value);
+    }
+
+
+    // Parses whitespace-separated numbers like operator>> does and stops at the first token that is not one, or when function returns false.
+    template<class functionType>
+    static const char* forEachParsedValue(const std::string_view text, functionType&& function)
+    {
+        const char* position { text.data() };
+
+        const char* const last { text.data() + text.size() };
+
+        for ( valueType value ;; )
+        {
+            while ( position not_eq last and compressedVectorTextIndex::isSpace(*position) )
+                ++position;
+
+            const char* const tokenBegin { position };
+
+            if ( last - position > 1 and *position == '+' and position[1] not_eq '-' )
+                ++position;
+
+            const auto [end, error] = std::from_chars(position, last, value);
+
+            if ( error not_eq std::errc{} )
+                return tokenBegin;
+
+            position = end;
+
+            if ( not function(value) )
+                return position;
+        }
+    }
+
+
+    [[nodiscard]] static constexpr bool isSameRunValue(const valueType& a, const valueType& b, const bool bitwiseEquality) noexcept
+    {
+        return bitwiseEquality ? compressedVectorRunEncoder<valueType>::template isSameRun<true>(a, b) : a == b;
+    }
+
+
+    // Appends the nodes of values placed at position, where previous is the value just before position.
+    static constexpr void appendRunNodes
+    (
+        std::vector<std::pair<keyType, valueType>>& nodes, 
+        const std::span<const valueType> values, 
+        const keyType& position, 
+        const valueType& previous, 
+        const bool bitwiseEquality
+    )
+    {
+        if ( values.empty() )
+            return;
+
+        if ( not isSameRunValue(values.front(), previous, bitwiseEquality) )
+            nodes.emplace_back(position, values.front());
+
+        compressedVectorRunEncoder<valueType>::forEachRunBoundary(values, bitwiseEquality, [&nodes, &values, &position](const std::size_t index) 
+        { 
+            nodes.emplace_back(position + ( keyType ) index, values[index]); 
+        });
+    }
+
+
+    // Appends little-endian values read from bytes, copying through a native-order block only on big-endian hosts.
+    static void appendBinaryRunNodes
+    (
+        std::vector<std::pair<keyType, valueType>>& nodes, 
+        const std::span<const std::byte> bytes, 
+        keyType& position, 
+        valueType& previous, 
+        const bool bitwiseEquality
+    )
+    {
+        const std::size_t count { bytes.size() / sizeof(valueType) };
+
+        if ( count == 0 )
+            return;
+
+        if constexpr ( std::endian::native == std::endian::little )
+        {
+            if ( ( std::uintptr_t ) bytes.data() % alignof(valueType) == 0 )
+            {
+                appendRunNodes(nodes, { ( const valueType* ) bytes.data(), count }, position, previous, bitwiseEquality);
+
+                position += ( keyType ) count;
+
+                previous = ( ( const valueType* ) bytes.data() )[count - 1];
+
+                return;
+            }
+        }
+
+        std::vector<valueType> block(std::min<std::size_t>(count, std::size_t(1) << 16));
+
+        for ( std::size_t done = 0; done < count; done += block.size() )
+        {
+            const std::span<valueType> values { block.data(), std::min(block.size(), count - done) };
+
+            std::memcpy(values.data(), bytes.data() + done * sizeof(valueType), values.size_bytes());
+
+            if constexpr ( std::endian::native not_eq std::endian::little )
+                for ( auto& value : values )
+                    std::ranges::reverse(std::as_writable_bytes(std::span<valueType, 1>{ &value, 1 }));
+
+            appendRunNodes(nodes, values, position, previous, bitwiseEquality);
+
+            position += ( keyType ) values.size();
+
+            previous = values.back();
+        }
+    }
+
+
+    [[nodiscard]] static constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> fromRunNodes
+    (
+        std::vector<std::pair<keyType, valueType>>& nodes, 
+        const keyType& startIndex, 
+        const std::size_t size, 
+        const valueType& initValue, 
+        double* ratio, 
+        const bool bitwiseEquality
+    )
+    {
+        const keyType endIndex { startIndex + ( keyType ) size };
+
+        if ( not nodes.empty() and not isSameRunValue(nodes.back().second, initValue, bitwiseEquality) )
+            nodes.emplace_back(endIndex, initValue);
+
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> resultArray { startIndex, endIndex, initValue };
+
+        resultArray.rebuildMap(nodes);
+
+        if ( ratio )
+            *ratio = size == 0 ? 0.0 : ( double ) resultArray.getByteSize() / ( double ) ( size * sizeof(valueType) );
+
+        return resultArray;
+    }
+
+
+    template<class functionType>
+    constexpr void forEachRunPair
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& from, 
+        const keyType& to, 
+        functionType&& function
+    ) const
+    {
+        if ( from == to )
+            return;
+
+        auto itThis = this->m_map.upper_bound(from);
+        auto itArray = array.m_map.upper_bound(from);
+
+        const auto itThisEnd = this->m_map.cend();
+        const auto itArrayEnd = array.m_map.cend();
+
+        valueType thisValue { itThis == this->m_map.cbegin() ? this->m_valBegin : std::prev(itThis)->second };
+        valueType arrayValue { itArray == array.m_map.cbegin() ? array.m_valBegin : std::prev(itArray)->second };
+
+        for ( keyType key { from } ; key < to ; )
+        {
+            keyType next { to };
+
+            if ( itThis not_eq itThisEnd )
+                next = std::min(next, itThis->first);
+
+            if ( itArray not_eq itArrayEnd )
+                next = std::min(next, itArray->first);
+
+            function(key, next, thisValue, arrayValue);
+
+            key = next;
+
+            for ( ; itThis not_eq itThisEnd and itThis->first == key ; ++itThis )
+                thisValue = itThis->second;
+
+            for ( ; itArray not_eq itArrayEnd and itArray->first == key ; ++itArray )
+                arrayValue = itArray->second;
+        }
+    }
+
+
+    template<class expressionType>
+    constexpr void assignExpression(const expressionType& expression)
+    {
+        [[maybe_unused]] const auto lock { expression.template lockOperands<threadSafe>(this->lockRequest(true)) };
+
+        const keyType from { expression.getMinIndex() }, to { expression.getMaxIndex() };
+
+        // Like c = a; c op= b, the result keeps the leftmost operand's initial value, and the operation is only applied 
+        // to values inside [from, to): evaluating it on the initial values could divide by a zero that never occurs in the range.
+        const valueType initValue { expression.getInitialValue() };
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        expression.forEachRun(from, to, [&nodes, &initValue](const keyType& begin, const keyType&, const valueType& value) 
+        { 
+            compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>::appendCanonicalNode(nodes, begin, value, initValue); 
+        });
+
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>::appendCanonicalNode(nodes, to, initValue, initValue);
+
+        this->minIndex = from;
+
+        this->maxIndex = to;
+
+        this->m_valBegin = initValue;
+
+        this->rebuildMap(nodes);
+    }
+
+
+    [[nodiscard]] constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> trimmedCopy(const keyType& from, const keyType& to) const
+    {
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> result { *this };
+
+        auto& map = result.m_map;
+
+        result.minIndex = from;
+
+        result.maxIndex = to;
+
+        map.erase(map.lower_bound(to), map.end());
+
+        const auto itBegin = map.upper_bound(from);
+
+        const valueType fromValue { itBegin == map.begin() ? this->m_valBegin : std::prev(itBegin)->second };
+
+        map.erase(map.begin(), itBegin);
+
+        if ( fromValue not_eq this->m_valBegin )
+            map.emplace_hint(map.begin(), from, fromValue);
+
+        if ( not map.empty() and map.crbegin()->second not_eq this->m_valBegin )
+            map.emplace_hint(map.end(), to, this->m_valBegin);
+
+        return result;
+    }
+
+
+    [[nodiscard]] constexpr auto lockWith(const bool exclusive, const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, const bool arrayExclusive) const
+    {
+        if constexpr ( threadSafe )
+            return compressedVectorLock<2>{ { this->lockRequest(exclusive), array.lockRequest(arrayExclusive) } };
+        else
+            return compressedVectorNoLock{};
+    }
+
+
+    constexpr void rebuildMap(const std::vector<std::pair<keyType, valueType>>& nodes)
+    {
+        this->m_map.clear();
+
+        for ( const auto& [key, value] : nodes )
+            this->m_map.emplace_hint(this->m_map.end(), key, value);
+    }
+
+
+    [[nodiscard]] static constexpr std::vector<std::tuple<keyType, keyType, valueType>> resolveWrites(const std::vector<std::tuple<keyType, keyType, valueType>>& writes)
+    {
+        std::vector<std::size_t> order(writes.size());
+
+        std::iota(order.begin(), order.end(), std::size_t(0));
+
+        std::sort(order.begin(), order.end(), [&writes](const std::size_t a, const std::size_t b) { return std::get<0>(writes[a]) < std::get<0>(writes[b]); });
+
+        std::vector<keyType> bounds;
+
+        bounds.reserve(2 * writes.size());
+
+        for ( const auto& [from, to, value] : writes )
+        {
+            bounds.push_back(from);
+
+            bounds.push_back(to);
+        }
+
+        std::sort(bounds.begin(), bounds.end());
+
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        std::vector<std::tuple<keyType, keyType, valueType>> result;
+
+        std::priority_queue<std::size_t> active;
+
+        auto itOrder = order.cbegin();
+
+        for ( std::size_t index = 0; index + 1 < bounds.size(); ++index )
+        {
+            const keyType& begin { bounds[index] };
+
+            const keyType& end { bounds[index + 1] };
+
+            for ( ; itOrder not_eq order.cend() and std::get<0>(writes[*itOrder]) == begin ; ++itOrder )
+                active.push(*itOrder);
+
+            while ( not active.empty() and std::get<1>(writes[active.top()]) <= begin )
+                active.pop();
+
+            if ( active.empty() )
+                continue;
+
+            const valueType& value { std::get<2>(writes[active.top()]) };
+
+            if ( not result.empty() and std::get<1>(result.back()) == begin and std::get<2>(result.back()) == value )
+                std::get<1>(result.back()) = end;
+
+            else
+                result.emplace_back(begin, end, value);
+        }
+
+        return result;
+    }
+
+
+    constexpr void coalesceMap(const keyType& from, const keyType& to)
+    {
+        for ( auto it = this->m_map.lower_bound(from); it not_eq this->m_map.end() and it->first <= to; )
+        {
+            if ( it->second == ( it == this->m_map.begin() ? this->m_valBegin : std::prev(it)->second ) )
+                it = this->m_map.erase(it);
+
+            else
+                ++it;
+        }
+    }
+
+
+public:
+
+    using value_type = valueType;
+
+    using key_type = keyType;
+
+    using pointer = const valueType*;
+
+    using const_pointer = const valueType*;
+
+    using reference = const valueType&;
+
+    using const_reference = const valueType&;
+
+    using size_type = std::size_t;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator = elementIterator;
+
+    using const_iterator = elementIterator;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using run_iterator = runIterator;
+
+    static constexpr bool isArithmeticSafe { arithmeticSafe };
+
+    static constexpr bool isThreadSafe { threadSafe };
+
+    using compressedVectorBase<threadSafe>::lockRead;
+
+    using compressedVectorBase<threadSafe>::lockWrite;
+
+
+    constexpr compressedVector():
+        minIndex{ keyType(0) }, maxIndex{ keyType(1) }, m_valBegin{ valueType(0) }, m_map{} {}
+
+
+    constexpr explicit compressedVector(const valueType& initValue):
+        minIndex{ keyType(0) }, maxIndex{ keyType(1) }, m_valBegin{ initValue }, m_map{} {}
+
+
+    constexpr compressedVector
+    (
+        const keyType& minIndexArg, 
+        const keyType& maxIndexArg, 
+        const valueType& initValue
+    ):
+        minIndex{ std::min(minIndexArg, maxIndexArg) }, maxIndex{ std::max(maxIndexArg, minIndexArg) }, m_valBegin{ initValue }, m_map{} {}
+
+
+    constexpr compressedVector
+    (
+        keyType minIndexArg, 
+        const valueType& initValue, 
+        const std::vector<std::pair<valueType, std::size_t>>& vectorValues
+    ):
+        minIndex{ minIndexArg }, 
+        maxIndex{ std::ranges::fold_left(vectorValues, minIndexArg, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; }) },
+        m_valBegin{ initValue }, 
+        m_map{}
+    {
+        this->assignValues(vectorValues);
+    }
+
+
+    constexpr compressedVector(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& other):
+        compressedVectorBase<threadSafe>{}, minIndex{}, maxIndex{}, m_valBegin{}, m_map{}
+    {
+        [[maybe_unused]] const auto otherLock { other.lockRead() };
+
+        this->minIndex = other.minIndex;
+
+        this->maxIndex = other.maxIndex;
+
+        this->m_valBegin = other.m_valBegin;
+
+        this->m_map = other.m_map;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& other) &
+    {
+        LOCK_WITH(true, other, false)
+
+        this->minIndex = other.minIndex;
+
+        this->maxIndex = other.maxIndex;
+
+        this->m_valBegin = other.m_valBegin;
+
+        this->m_map = other.m_map;
+
+        return *this;
+    }
+
+
+    constexpr compressedVector(compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>&& other):
+        compressedVectorBase<threadSafe>{}, minIndex{}, maxIndex{}, m_valBegin{}, m_map{}
+    {
+        [[maybe_unused]] const auto otherLock { other.lockWrite() };
+
+        this->minIndex = other.minIndex;
+
+        this->maxIndex = other.maxIndex;
+
+        this->m_valBegin = other.m_valBegin;
+
+        this->m_map = std::move(other.m_map);
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator=(compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>&& other) &
+    {
+        if ( this not_eq &other )
+        {
+            LOCK_WITH(true, other, true)
+
+            this->minIndex = other.minIndex;
+
+            this->maxIndex = other.maxIndex;
+
+            this->m_valBegin = other.m_valBegin;
+
+            this->m_map = std::move(other.m_map);
+        }
+
+        return *this;
+    }
+
+
+    template<CompressedExpression expressionType>
+    constexpr compressedVector(const expressionType& expression):
+        minIndex{}, maxIndex{}, m_valBegin{}, m_map{}
+        {
+            this->assignExpression(expression);
+        }
+
+
+    template<CompressedExpression expressionType>
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator=(const expressionType& expression)
+    {
+        this->assignExpression(expression);
+
+        return *this;
+    }
+
+
+    constexpr void reset(const valueType& value)
+    {
+        LOCK_WRITE
+
+        this->m_valBegin = value;
+
+        this->m_map.clear();
+    }
+
+
+    [[nodiscard]] constexpr std::conditional_t<threadSafe, valueType, const valueType&> operator[](keyType const& key) const 
+    {
+        LOCK_READ
+
+        if( const auto& it = this->m_map.upper_bound(key); it not_eq this->m_map.cbegin() )
+            return std::prev(it)->second;
+        else 
+            return this->m_valBegin;
+    }
+
+
+    [[nodiscard]] constexpr const_iterator begin(void) const { return { this, this->minIndex, this->maxIndex, this->minIndex }; }
+
+    [[nodiscard]] constexpr const_iterator end(void) const { return { this, this->minIndex, this->maxIndex, this->maxIndex }; }
+
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->begin(); }
+
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->end(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator{ this->end() }; }
+
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator{ this->begin() }; }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
+
+
+    [[nodiscard]] constexpr auto elements(const keyType& fromArg, const keyType& toArg) const
+    {
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        return std::ranges::subrange<const_iterator>{ const_iterator{ this, from, to, from }, const_iterator{ this, from, to, to } };
+    }
+
+
+    [[nodiscard]] constexpr auto runs(const keyType& fromArg, const keyType& toArg) const
+    {
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        return std::ranges::subrange<run_iterator, std::default_sentinel_t>{ run_iterator{ const_iterator{ this, from, to, from } }, std::default_sentinel };
+    }
+
+
+    [[nodiscard]] constexpr auto runs(void) const
+    {
+        return this->runs(this->minIndex, this->maxIndex);
+    }
+
+
+    [[nodiscard]] constexpr compressedVectorView<compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>> view(const keyType& fromArg, const keyType& toArg) const
+    {
+        return { *this, fromArg, toArg };
+    }
+
+
+    [[nodiscard]] constexpr compressedVectorView<compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>> view(void) const
+    {
+        return { *this, this->minIndex, this->maxIndex };
+    }
+
+
+    [[maybe_unused]] constexpr bool lookup(std::span<const keyType> keys, std::span<valueType> values) const
+    {
+        LOCK_READ
+
+        if ( values.size() < keys.size() )
+            return false;
+
+        const bool sorted { std::is_sorted(keys.begin(), keys.end()) };
+
+        if constexpr ( requires { this->m_map.upperBoundIndices(keys, [](std::size_t, std::size_t) {}); this->m_map.getValues(); } )
+        {
+            if ( not sorted )
+            {
+                const auto mapValues = this->m_map.getValues();
+
+                this->m_map.upperBoundIndices(keys, [this, &values, &mapValues](const std::size_t index, const std::size_t bound) 
+                    { values[index] = ( bound == 0 ? this->m_valBegin : mapValues[bound - 1] ); });
+
+                return true;
+            }
+        }
+
+        const auto itEnd = this->m_map.cend();
+
+        const std::size_t maxSteps = ( sorted ? ( std::size_t ) std::bit_width(( std::size_t ) std::bit_width(this->m_map.size())) : 0 );
+
+        auto it = itEnd;
+
+        const valueType* current { &this->m_valBegin };
+
+        for ( std::size_t index = 0; index < keys.size(); ++index )
+        {
+            const keyType& key { keys[index] };
+
+            std::size_t steps { 0 };
+
+            if ( index not_eq 0 and sorted )
+            {
+                for ( ; it not_eq itEnd and it->first <= key and steps < maxSteps; ++it, ++steps )
+                    current = &it->second;
+            }
+
+            if ( index == 0 or steps == maxSteps )
+            {
+                it = this->m_map.upper_bound(key);
+
+                current = ( it == this->m_map.cbegin() ? &this->m_valBegin : &std::prev(it)->second );
+            }
+
+            values[index] = *current;
+        }
+
+        return true;
+    }
+
+
+    [[nodiscard]] constexpr bool operator==(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& other) const
+    {
+        LOCK_WITH(false, other, false)
+
+        return this->minIndex == other.minIndex and this->maxIndex == other.maxIndex and this->m_valBegin == other.m_valBegin and this->m_map == other.m_map;
+    }
+    
+
+    [[nodiscard]] constexpr std::conditional_t<threadSafe, valueType, const valueType&> getInitialValue(void) const noexcept
+    {
+        LOCK_READ
+
+        return this->m_valBegin;
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getMapSize(void) const noexcept 
+    { 
+        LOCK_READ
+
+        return this->m_map.size(); 
+    }
+
+
+    [[nodiscard]] constexpr std::size_t getByteSize(void) const noexcept
+    {
+        LOCK_READ
+
+        std::size_t size { 2 * sizeof(keyType) + sizeof(valueType) };
+
+        if constexpr ( requires { this->m_map.getByteSize(); } )
+            size += this->m_map.getByteSize();
+
+        else
+            size += sizeof(decltype(this->m_map)) + sizeof(typename decltype(this->m_map)::value_type) * this->m_map.size();
+
+        if constexpr ( threadSafe )
+            return size + sizeof(decltype(this->mutex));
+
+        else
+            return size;
+    }
+
+
+    [[nodiscard]] constexpr keyType getMinIndex(void) const noexcept 
+    { 
+        LOCK_READ
+
+        return this->minIndex;
+    }
+
+
+    [[nodiscard]] constexpr keyType getMaxIndex(void) const noexcept 
+    { 
+        LOCK_READ
+
+        return this->maxIndex;
+    }
+
+
+    [[nodiscard]] constexpr std::pair<keyType, keyType> getMinMaxIndex(void) const
+    {
+        LOCK_READ
+
+        return { this->minIndex, this->maxIndex };
+    }
+
+
+    [[nodiscard]] constexpr auto getLength(void) const noexcept
+    {
+        LOCK_READ
+
+        return ( std::size_t ) ( this->maxIndex - this->minIndex );
+    }
+
+
+    [[nodiscard]] constexpr std::pair<keyType, keyType> getValidRange
+    (
+        const keyType& from, 
+        const keyType& to
+    ) const
+    {
+        LOCK_READ
+
+        if ( to <= from )
+            return { from, from };
+
+        if ( to <= this->minIndex )
+            return { this->minIndex, this->minIndex };
+
+        if ( this->maxIndex <= from )
+            return { this->maxIndex, this->maxIndex };
+
+        return { this->minIndex <= from ? from : this->minIndex, to <= this->maxIndex ? to : this->maxIndex };
+    }
+
+
+    [[nodiscard]] constexpr bool contains
+    (
+        const keyType& fromArg, 
+        const keyType& toArg,
+        const valueType& value
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to ) 
+            return false;
+
+        if ( (*this)[from] == value )
+            return true;
+
+        if constexpr ( requires { this->m_map.findValueKeys(value); } )
+        {
+            const auto* keys = this->m_map.findValueKeys(value);
+
+            if ( keys == nullptr )
+                return false;
+
+            const auto it = keys->upper_bound(from);
+
+            return it not_eq keys->cend() and *it < to;
+        }
+        else
+        {
+            const auto itEnd = this->m_map.lower_bound(to);
+
+            return std::find_if(this->m_map.upper_bound(from), itEnd, 
+                [&value](const auto& p) { return p.second == value; }) not_eq itEnd;
+        }
+    }
+
+
+    [[nodiscard]] constexpr bool contains(const valueType& value) const
+    {
+        LOCK_READ
+
+        return this->contains(this->minIndex, this->maxIndex, value);
+    }
+
+
+    [[maybe_unused]] constexpr bool setMinIndex(const keyType& index)
+    {
+        LOCK_WRITE
+
+        if ( index >= this->maxIndex )
+            return false;
+
+        this->minIndex = index;
+
+        this->m_map.erase( this->m_map.cbegin(), this->m_map.lower_bound(index) );
+
+        return true;
+    }
+
+
+    [[maybe_unused]] constexpr bool setMaxIndex(const keyType& index)
+    {
+        LOCK_WRITE
+
+        if ( index <= this->minIndex )
+            return false;
+
+        this->maxIndex = index;
+
+        this->m_map.erase( this->m_map.upper_bound(index), this->m_map.cend() );
+
+        return true;
+    }
+
+
+    [[maybe_unused]] constexpr bool setMinMaxIndex
+    (
+        const keyType& minIndexArg, 
+        const keyType& maxIndexArg
+    )
+    {
+        LOCK_WRITE
+
+        return this->setMinIndex(minIndexArg) and this->setMaxIndex(maxIndexArg);
+    }
+
+
+    constexpr void setInitValue(const valueType& value)
+    {
+        LOCK_WRITE
+
+        this->m_valBegin = value;
+
+        if ( this->m_map.empty() )
+            return;
+
+        if ( value == this->m_map.cbegin()->second )
+            this->m_map.erase(this->m_map.cbegin());
+
+        if ( this->m_map.size() == 1 )
+        {
+            this->m_map.clear();
+
+            return;
+        }
+
+        this->setMapValue(std::prev(this->m_map.end()), value);
+    }
+
+
+    constexpr void assignValue
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const valueType& value
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to ) 
+            return;
+
+        if ( m_map.empty() )
+        {
+            if ( value not_eq this->m_valBegin )
+                this->m_map = { { from, value }, { to, this->m_valBegin } };
+
+            return;
+        }
+
+        typename decltype(this->m_map)::iterator itBegin, itEnd = this->m_map.lower_bound(to);
+
+        if ( itEnd == this->m_map.cend() )
+        {
+            if ( value not_eq this->m_valBegin )
+                itEnd = this->m_map.emplace_hint(itEnd, to, this->m_valBegin);
+
+            itBegin = std::prev(itEnd);
+        }
+
+        else
+        {
+            if ( itEnd == this->m_map.cbegin() )
+            {
+                if ( to < itEnd->first and value not_eq this->m_valBegin )
+                    itEnd = this->m_map.emplace_hint(itEnd, to, this->m_valBegin);
+            }
+
+            else if ( const valueType& prevItEndVal = std::prev(itEnd)->second; to < itEnd->first and value not_eq prevItEndVal )
+                itEnd = this->m_map.emplace_hint(itEnd, to, prevItEndVal);
+
+            itBegin = itEnd;
+        }
+
+        for ( ; itBegin not_eq this->m_map.cbegin() and from < itBegin->first ; --itBegin );
+
+        if ( itBegin->first < from )
+            ++itBegin;
+
+        if ( itBegin == this->m_map.cend() )
+            return;
+
+        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
+
+        if ( from < itBegin->first )
+        {
+            const auto& itEndErase = this->m_map.erase(itBegin, itEnd not_eq this->m_map.cend() and itEnd->second == value ? std::next(itEnd) : itEnd);
+            
+            if ( value not_eq prevItBeginVal )
+                this->m_map.emplace_hint(itEndErase, from, value);
+        }
+
+        else
+        {
+            if ( value not_eq prevItBeginVal )
+                this->setMapValue(itBegin++, value);
+        
+            this->m_map.erase(itBegin, itEnd not_eq this->m_map.cend() and itEnd->second == value ? std::next(itEnd) : itEnd);
+        }
+    }
+
+
+    constexpr void assignValues(std::span<const std::tuple<keyType, keyType, valueType>> ranges)
+    {
+        LOCK_WRITE
+
+        std::vector<std::tuple<keyType, keyType, valueType>> writes;
+
+        writes.reserve(ranges.size());
+
+        bool disjoint { true };
+
+        for ( const auto& [fromArg, toArg, value] : ranges )
+        {
+            if ( const auto [from, to] = this->getValidRange(fromArg, toArg); from not_eq to )
+            {
+                disjoint = disjoint and ( writes.empty() or std::get<1>(writes.back()) <= from );
+
+                writes.emplace_back(from, to, value);
+            }
+        }
+
+        if ( writes.empty() )
+            return;
+
+        if ( not disjoint )
+            writes = this->resolveWrites(writes);
+
+        if ( writes.size() * ( std::size_t ) std::bit_width(this->m_map.size()) < this->m_map.size() )
+        {
+            for ( const auto& [from, to, value] : writes )
+                this->assignValue(from, to, value);
+
+            return;
+        }
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        nodes.reserve(this->m_map.size() + 2 * writes.size());
+
+        const auto emit = [this, &nodes](const keyType& key, const valueType& value) { this->appendCanonicalNode(nodes, key, value, this->m_valBegin); };
+
+        auto it = this->m_map.cbegin();
+
+        const auto itEnd = this->m_map.cend();
+
+        valueType existing { this->m_valBegin };
+
+        for ( const auto& [from, to, value] : writes )
+        {
+            for ( ; it not_eq itEnd and it->first < from ; ++it )
+            {
+                emit(it->first, it->second);
+
+                existing = it->second;
+            }
+
+            emit(from, value);
+
+            for ( ; it not_eq itEnd and it->first <= to ; ++it )
+                existing = it->second;
+
+            emit(to, existing);
+        }
+
+        for ( ; it not_eq itEnd ; ++it )
+            emit(it->first, it->second);
+
+        this->rebuildMap(nodes);
+    }
+
+
+    constexpr void assignValues(const std::vector<std::pair<valueType, std::size_t>>& values)
+    {
+        LOCK_WRITE
+
+        this->assignValues(this->minIndex, this->maxIndex, values);
+    }
+
+
+    constexpr void assignValues
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const std::vector<std::pair<valueType, std::size_t>>& values
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to or values.empty() ) 
+            return;
+
+        std::size_t startIndex { 0 }, reduceFirst { 0 };
+
+        auto diff = from - fromArg;
+
+        if ( std::cmp_greater(diff, 0) )
+        {
+            for ( const auto& item : values )
+            {   
+                diff -= ( keyType ) item.second;
+
+                if ( std::cmp_less(diff, 0) )
+                {
+                    reduceFirst = item.second - ( std::size_t ) -diff ;
+
+                    break;
+                }
+
+                ++startIndex;
+            }
+        }
+
+        if ( std::cmp_equal(startIndex, values.size()) )
+            return;
+
+        std::vector<std::pair<valueType, std::size_t>> fixedValues = { values[startIndex] };
+
+        fixedValues.front().second -= reduceFirst;
+
+        const std::size_t rangeSize = ( std::size_t ) std::llround(std::ceil(to - from));
+
+        std::size_t size { fixedValues.front().second };
+
+        for ( std::size_t index { startIndex + 1 } ; index not_eq values.size() and size < rangeSize ; )
+        {
+            const auto& item = values[index++];
+
+            if ( item.first not_eq fixedValues.back().first )
+            {
+                if ( item.second )
+                    fixedValues.push_back(item);
+            }
+
+            else
+                fixedValues.back().second += item.second;
+
+            size += item.second;
+        }
+
+        if ( size > rangeSize )
+        {
+            fixedValues.back().second -= (size - rangeSize);
+
+            size = rangeSize;
+        }
+
+        if ( std::cmp_equal(fixedValues.back().second, 0) )
+            fixedValues.pop_back();
+
+        if ( fixedValues.empty() )
+            return;
+
+        if ( std::cmp_equal(fixedValues.size(), 1) )
+        {
+            this->assignValue(from, from + ( keyType ) fixedValues.front().second, fixedValues.front().first);
+
+            return;
+        }
+
+        if ( m_map.empty() )
+        {
+            keyType position = ( keyType ) from;
+
+            for ( const auto& item : fixedValues )
+            {
+                this->m_map.emplace_hint(this->m_map.cend(), position, item.first);
+
+                position += ( keyType ) item.second;
+            }
+
+            if ( ( not this->m_map.empty() ) and this->m_map.crbegin()->second not_eq this->m_valBegin )
+                this->m_map.emplace_hint(this->m_map.cend(), position, this->m_valBegin);
+
+            if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
+                this->m_map.erase(this->m_map.cbegin());
+
+            return;
+        }
+
+        const auto positionTemp = from + ( keyType ) size - ( keyType ) fixedValues.back().second;
+
+        auto position { positionTemp };
+
+        this->assignValue(from, from + ( keyType ) fixedValues.front().second, fixedValues.front().first);
+
+        this->assignValue(( keyType ) position, from + ( keyType ) size, fixedValues.back().first);
+
+        if ( std::cmp_equal(fixedValues.size(), 2) )
+            return;
+
+        const auto secondPrevEndIt = std::prev(fixedValues.cend(), 2);
+
+        position -= ( decltype(position) ) secondPrevEndIt->second;
+
+        this->assignValue(( keyType ) position, positionTemp, secondPrevEndIt->first);
+
+        if ( std::cmp_equal(fixedValues.size(), 3) )
+            return;
+
+        auto it = std::prev(this->m_map.find(positionTemp));
+
+        it = this->m_map.erase(this->m_map.upper_bound(from), it);
+
+        if ( std::cmp_not_equal(it->first, position) )
+            it = this->m_map.emplace_hint(this->m_map.erase(it), position, secondPrevEndIt->first);
+
+        for ( auto valuesIt { std::prev(fixedValues.cend(), 3) } ; valuesIt not_eq fixedValues.cbegin() ; --valuesIt )
+        {
+            position -= ( decltype(position) ) valuesIt->second;
+
+            it = this->m_map.emplace_hint(it, position, valuesIt->first);
+        }
+        /* Maybe not needed */
+        if ( ( not this->m_map.empty() ) and this->m_map.crbegin()->second not_eq this->m_valBegin )
+            this->m_map.emplace_hint(this->m_map.cend(), position, this->m_valBegin);
+        /* Maybe not needed */
+        if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
+            this->m_map.erase(this->m_map.cbegin());
+    }
+
+
+    constexpr void assignRangeFromArray
+    (
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromA, 
+        const keyType& toA,
+        const keyType& fromB, 
+        const keyType& toB
+    )
+    {
+        LOCK_WITH(true, array, false)
+
+        // TODO
+    }
+
+
+    constexpr void swapRangesWithArray
+    (
+        const keyType& fromA, 
+        const keyType& toA, 
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromB, 
+        const keyType& toB
+    )
+    {
+        LOCK_WITH(true, array, true)
+
+        // TODO
+    }
+
+
+    constexpr void swapRanges
+    (
+        const keyType& fromA, 
+        const keyType& toA, 
+        const keyType& fromB, 
+        const keyType& toB
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void copyRange
+    (
+        const keyType& fromA, 
+        const keyType& toA, 
+        const keyType& fromB, 
+        const keyType& toB
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void insertValuesAfterPosition
+    (
+        const keyType& position, 
+        const std::vector<std::pair<valueType, std::size_t>>& values,
+        const bool expandLeft = false
+    )
+    {
+        LOCK_WRITE
+
+        if ( position < this->minIndex or position >= this->maxIndex or values.empty() )
+            return;
+
+        std::vector<std::pair<valueType, std::size_t>> fixedValues;
+
+        std::size_t size { 0 };
+
+        for ( const auto& item : values )
+        {
+            if ( not item.second )
+                continue;
+
+            if ( fixedValues.empty() or item.first not_eq fixedValues.back().first )
+                fixedValues.push_back(item);
+
+            else
+                fixedValues.back().second += item.second;
+
+            size += item.second;
+        }
+
+        if ( fixedValues.empty() )
+            return;
+
+        const keyType insertKey = position + keyType(1);
+
+        auto itSplit = this->splitMapAt(insertKey);
+
+        auto index = insertKey;
+
+        if ( expandLeft )
+        {
+            this->shiftMapKeys(this->m_map.begin(), itSplit, ( keyType ) -size);
+
+            index -= ( keyType ) size;
+
+            this->minIndex -= ( keyType ) size;
+        }
+
+        else
+        {
+            itSplit = this->shiftMapKeys(itSplit, this->m_map.end(), ( keyType ) size);
+
+            this->maxIndex += ( keyType ) size;
+        }
+
+        const auto firstKey = index;
+
+        for ( const auto& [value, freq] : fixedValues )
+        {
+            itSplit = std::next(this->m_map.emplace_hint(itSplit, index, value));
+
+            index += ( keyType ) freq;
+        }
+
+        this->coalesceMap(firstKey, index);
+    }
+
+
+    constexpr void appendValues
+    (
+        const std::vector<std::pair<valueType, std::size_t>>& values, 
+        const bool expandLeft = false
+    )
+    {
+        LOCK_WRITE
+
+        if ( expandLeft )
+        {
+            const auto prevMinIndex = this->minIndex;
+
+            this->minIndex = std::ranges::fold_left(values, this->minIndex, [](const keyType& left, const auto& right){ return left - ( keyType ) right.second; });
+
+            const auto insertedSize = prevMinIndex - this->minIndex;
+
+            this->shiftMapKeys(this->m_map.begin(), this->m_map.end(), ( keyType ) -insertedSize);
+
+            this->assignValues(this->maxIndex - insertedSize, this->maxIndex, values);
+
+            return;
+        }
+
+        const auto prevMaxIndex = this->maxIndex;
+
+        this->maxIndex = std::ranges::fold_left(values, this->maxIndex, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; });
+
+        this->assignValues(prevMaxIndex, this->maxIndex, values);
+    }
+
+
+    constexpr void prependValues
+    (
+        const std::vector<std::pair<valueType, std::size_t>>& values, 
+        const bool expandLeft = false
+    )
+    {
+        LOCK_WRITE
+
+        if ( expandLeft )
+        {
+            const auto prevMinIndex = this->minIndex;
+
+            this->minIndex = std::ranges::fold_left(values, this->minIndex, [](const keyType& left, const auto& right){ return left - ( keyType ) right.second; });
+
+            this->assignValues(this->minIndex, prevMinIndex, values);
+
+            return;
+        }
+
+        const auto prevMaxIndex = this->maxIndex;
+
+        this->maxIndex = std::ranges::fold_left(values, this->maxIndex, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; });
+
+        const auto insertedSize = this->maxIndex - prevMaxIndex;
+
+        this->shiftMapKeys(this->m_map.begin(), this->m_map.end(), insertedSize);
+
+        this->assignValues(this->minIndex, this->minIndex + insertedSize, values);
+    }
+
+
+    constexpr void erase
+    (
+        const keyType& fromArg, 
+        const keyType& toArg,
+        const bool shrinkRight = false
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to ) 
+            return;
+
+        const auto difference = to - from;
+
+        auto itEnd = this->splitMapAt(to);
+
+        itEnd = this->m_map.erase(this->m_map.lower_bound(from), itEnd);
+
+        if ( shrinkRight )
+        {
+            this->shiftMapKeys(this->m_map.begin(), itEnd, difference);
+
+            this->minIndex += difference;
+
+            this->coalesceMap(to, to);
+        }
+
+        else
+        {
+            this->shiftMapKeys(itEnd, this->m_map.end(), ( keyType ) -difference);
+
+            this->maxIndex -= difference;
+
+            this->coalesceMap(from, from);
+        }
+    }
+
+
+    constexpr void increaseValueRange
+    (
+        const keyType& from, 
+        const keyType& to, 
+        const valueType& value, 
+        const std::size_t amount,
+        const bool expandLeft = false
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void decreaseValueRange
+    (
+        const keyType& from, 
+        const keyType& to, 
+        const valueType& value, 
+        const std::size_t amount,
+        const bool shrinkRight = false
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void changeValueRange
+    (
+        const keyType& from, 
+        const keyType& to, 
+        const valueType& value, 
+        const std::size_t newRange
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void shiftLeft(const keyType& difference = keyType(1))
+    {
+        LOCK_WRITE
+
+        this->shiftMapKeys(this->m_map.begin(), this->m_map.end(), ( keyType ) -difference);
+
+        this->minIndex -= difference;
+
+        this->maxIndex -= difference;
+    }
+
+
+    constexpr void shiftRight(const keyType& difference = keyType(1))
+    {
+        LOCK_WRITE
+
+        this->shiftMapKeys(this->m_map.begin(), this->m_map.end(), difference);
+
+        this->minIndex += difference;
+
+        this->maxIndex += difference;
+    }
+
+
+    constexpr void shiftRangeLeft
+    (
+        const keyType& from, 
+        const keyType& to, 
+        const keyType& difference = keyType(1), 
+        const valueType& fillValue = valueType(0)
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void shiftRangeRight
+    (
+        const keyType& from, 
+        const keyType& to, 
+        const keyType& difference = keyType(1), 
+        const valueType& fillValue = valueType(0)
+    )
+    {
+        LOCK_WRITE
+
+        // TODO
+    }
+
+
+    constexpr void reverseValues(void)
+    {
+        LOCK_WRITE
+
+        this->reverseValues(this->minIndex, this->maxIndex);
+    }
+
+
+    constexpr void reverseValues
+    (
+        const keyType& fromArg, 
+        const keyType& toArg
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to or this->m_map.empty() )
+            return;
+
+        this->splitMapAt(to);
+
+        auto itBegin = this->splitMapAt(from);
+        auto itEnd = this->m_map.lower_bound(to);
+
+        std::vector<std::pair<valueType, keyType>> runs;
+
+        for ( auto it = itBegin; it not_eq itEnd; ++it )
+            runs.emplace_back(it->second, std::next(it)->first - it->first);
+
+        itEnd = this->m_map.erase(itBegin, itEnd);
+
+        auto currentIndex = from;
+
+        for ( auto it = runs.crbegin(); it not_eq runs.crend(); ++it )
+        {
+            itEnd = std::next(this->m_map.emplace_hint(itEnd, currentIndex, it->first));
+
+            currentIndex += it->second;
+        }
+
+        this->coalesceMap(from, to);
+    }
+
+
+    constexpr void sortValues
+    (
+        const bool reverse = false,
+        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
+    )
+    {
+        LOCK_WRITE
+
+        this->sortValues(this->minIndex, this->maxIndex, reverse, compareFunction);
+    }
+
+
+    constexpr void sortValues
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const bool reverse = false,
+        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to or this->m_map.empty() )
+            return;
+
+        this->splitMapAt(to);
+
+        auto itBegin = this->splitMapAt(from);
+        auto itEnd = this->m_map.lower_bound(to);
+
+        auto comparator = [reverse, &compareFunction](const auto& a, const auto& b) { return reverse ? compareFunction(b, a) : compareFunction(a, b); };
+
+        std::map<valueType, std::size_t, decltype(comparator)> orderedValuesMap{ comparator };
+
+        for ( auto it = itBegin; it not_eq itEnd; ++it )
+            orderedValuesMap[it->second] += ( std::size_t ) ( std::next(it)->first - it->first );
+        
+        itEnd = this->m_map.erase(itBegin, itEnd);
+
+        auto currentKey = from;    
+
+        for ( const auto& [value, count] : orderedValuesMap )
+        {
+            itEnd = std::next(this->m_map.emplace_hint(itEnd, currentKey, value));
+
+            currentKey += ( keyType ) count;
+        }
+
+        this->coalesceMap(from, to);
+    }
+
+
+    constexpr void replaceValue
+    (
+        const valueType& oldValue, 
+        const valueType& newValue
+    )
+    {
+        LOCK_WRITE
+
+        this->replaceValue(this->minIndex, this->maxIndex, oldValue, newValue);
+    }
+
+
+    constexpr void replaceValue
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const valueType& oldValue, 
+        const valueType& newValue
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to or oldValue == newValue )
+            return;
+
+        this->splitMapAt(to);
+
+        for ( auto it = this->splitMapAt(from); it->first not_eq to; ++it )
+            if ( it->second == oldValue )
+                this->setMapValue(it, newValue);
+
+        this->coalesceMap(from, to);
+    }
+
+
+    constexpr void apply(const std::function<valueType(const valueType&)>& appliedFunction)
+    {
+        LOCK_WRITE
+
+        this->apply(this->minIndex, this->maxIndex, appliedFunction);
+    }
+
+
+    constexpr void apply
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const std::function<valueType(const valueType&)>& appliedFunction
+    )
+    {
+        LOCK_WRITE
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return ;
+
+        this->splitMapAt(to);
+
+        for ( auto it = this->splitMapAt(from); it->first not_eq to; ++it )
+            this->setMapValue(it, appliedFunction(it->second));
+
+        this->coalesceMap(from, to);
+    }
+
+
+    constexpr void operationWithArray
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const std::function<valueType(const valueType&, const valueType&)>& operation
+    )
+    {
+        LOCK_WITH(true, array, false)
+
+        this->operationWithArray(array, this->minIndex, this->maxIndex, operation);
+    }
+
+
+    constexpr void operationWithArray
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const std::function<valueType(const valueType&, const valueType&)>& operation
+    )
+    {
+        LOCK_WITH(true, array, false)
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return;
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        nodes.reserve(this->m_map.size() + array.m_map.size() + 2);
+
+        auto itThis = this->m_map.cbegin();
+        auto itArray = array.m_map.cbegin();
+
+        const auto itThisEnd = this->m_map.cend();
+        const auto itArrayEnd = array.m_map.cend();
+
+        valueType thisValue { this->m_valBegin }, arrayValue { array.m_valBegin };
+
+        for ( ; itThis not_eq itThisEnd and itThis->first < from ; ++itThis )
+        {
+            this->appendCanonicalNode(nodes, itThis->first, itThis->second, this->m_valBegin);
+
+            thisValue = itThis->second;
+        }
+
+        for ( ; itArray not_eq itArrayEnd and itArray->first < from ; ++itArray )
+            arrayValue = itArray->second;
+
+        for ( keyType key { from } ; key < to ; )
+        {
+            for ( ; itThis not_eq itThisEnd and itThis->first == key ; ++itThis )
+                thisValue = itThis->second;
+
+            for ( ; itArray not_eq itArrayEnd and itArray->first == key ; ++itArray )
+                arrayValue = itArray->second;
+
+            this->appendCanonicalNode(nodes, key, operation(thisValue, arrayValue), this->m_valBegin);
+
+            key = to;
+
+            if ( itThis not_eq itThisEnd )
+                key = std::min(key, itThis->first);
+
+            if ( itArray not_eq itArrayEnd )
+                key = std::min(key, itArray->first);
+        }
+
+        for ( ; itThis not_eq itThisEnd and itThis->first == to ; ++itThis )
+            thisValue = itThis->second;
+
+        this->appendCanonicalNode(nodes, to, thisValue, this->m_valBegin);
+
+        for ( ; itThis not_eq itThisEnd ; ++itThis )
+            this->appendCanonicalNode(nodes, itThis->first, itThis->second, this->m_valBegin);
+
+        this->rebuildMap(nodes);
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator+=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::is_arithmetic_v<valueType>
+    {
+        this->operationWithArray(array, [](const valueType& a, const valueType& b) { return safeAdd<valueType, arithmeticSafe>(a, b); });
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator-=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::is_arithmetic_v<valueType>
+    {
+        this->operationWithArray(array, [](const valueType& a, const valueType& b) { return safeSubstract<valueType, arithmeticSafe>(a, b); });
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator*=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::is_arithmetic_v<valueType>
+    {
+        this->operationWithArray(array, [](const valueType& a, const valueType& b) { return safeMultiply<valueType, arithmeticSafe>(a, b); });
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator/=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::is_arithmetic_v<valueType>
+    {
+        this->operationWithArray(array, [](const valueType& a, const valueType& b) { return safeDivide<valueType, arithmeticSafe>(a, b); });
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator%=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::integral<valueType>
+    {
+        this->operationWithArray(array, std::modulus<valueType>{});
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator&=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::integral<valueType>
+    {
+        this->operationWithArray(array, std::bit_and<valueType>{});
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator|=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::integral<valueType>
+    {
+        this->operationWithArray(array, std::bit_or<valueType>{});
+
+        return *this;
+    }
+
+
+    constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& operator^=(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array) requires std::integral<valueType>
+    {
+        this->operationWithArray(array, std::bit_xor<valueType>{});
+
+        return *this;
+    }
+
+
+    [[nodiscard]] constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> getSubArray
+    (
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return {};
+
+        if ( from == this->minIndex and to == this->maxIndex )
+            return *this;
+
+        if constexpr ( requires { storageType<keyType, valueType>::isCopyOnWrite; } )
+            return this->trimmedCopy(from, to);
+        else
+            return compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>{ compressedVectorTerminal<compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>>{ *this, from, to } };
+    }
+
+
+    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, valueType>> getValues(const bool shrink = false) const
+    {
+        LOCK_READ
+
+        return this->getValues(this->minIndex, this->maxIndex, shrink);
+    }
+
+
+    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, valueType>> getValues
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const bool shrink = false
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to ) 
+            return {};
+
+        if ( this->m_map.empty() )
+            return { { from, to, this->m_valBegin } };
+
+        const auto itBegin = this->m_map.upper_bound(from);
+        const auto itEnd = this->m_map.upper_bound(to);
+
+        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
+            return { { from, to, this->m_valBegin } };
+
+        if ( itBegin == itEnd )
+            return { { from, to, std::prev(itBegin)->second } };
+
+        std::vector<std::tuple<keyType, keyType, valueType>> result = { { from, itBegin->first, itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second } };
+
+        for ( auto it = std::next(itBegin) ; it not_eq itEnd ; ++it )
+        {
+            const auto& prevIt = std::prev(it);
+
+            result.emplace_back(prevIt->first, it->first, prevIt->second);
+        }
+
+        if ( const auto& prevItEnd = std::prev(itEnd); prevItEnd->first not_eq to )
+            result.emplace_back(prevItEnd->first, to, prevItEnd->second);
+
+        if ( shrink )
+            result.shrink_to_fit();
+
+        return result;
+    }
+
+
+    [[nodiscard]] constexpr std::unordered_set<valueType> getSetValues(void) const
+    {
+        LOCK_READ
+
+        return this->getRangeSetValues(this->minIndex, this->maxIndex);
+    }
+
+
+    [[nodiscard]] constexpr std::unordered_set<valueType> getSetValues
+    (
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to ) 
+            return {};
+
+        if ( this->m_map.empty() )
+            return { this->m_valBegin };
+
+        const auto itBegin = this->m_map.upper_bound(from);
+        const auto itEnd = this->m_map.upper_bound(to);
+
+        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
+            return { this->m_valBegin };
+
+        if ( itBegin == itEnd )
+            return { std::prev(itBegin)->second };
+
+        std::unordered_set<valueType> result = { itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second };
+
+        for ( auto it = std::next(itBegin) ; it not_eq itEnd ; ++it )
+        {
+            const auto& prevIt = std::prev(it);
+
+            result.insert(prevIt->second);
+        }
+
+        if ( const auto& prevItEnd = std::prev(itEnd); prevItEnd->first not_eq to )
+            result.insert(prevItEnd->second);
+
+        return result;
+    }
+
+
+    [[nodiscard]] constexpr std::map<valueType, std::size_t> getRangeValueFrequencies(void) const
+    {
+        LOCK_READ
+
+        return this->getRangeValueFrequencies(this->minIndex, this->maxIndex);
+    }
+
+
+    [[nodiscard]] constexpr std::map<valueType, std::size_t> getRangeValueFrequencies
+    (
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        std::map<valueType, std::size_t> resultMap;
+
+        if constexpr ( requires { this->m_map.getValueLengths(); } )
+        {
+            if ( from == this->minIndex and to == this->maxIndex and 
+                ( this->m_map.empty() or ( this->minIndex <= this->m_map.cbegin()->first and this->m_map.crbegin()->first <= this->maxIndex ) ) )
+            {
+                for ( const auto& [value, length] : this->m_map.getValueLengths() )
+                    resultMap.emplace(value, length);
+
+                const std::size_t outside = ( this->m_map.empty() ? ( std::size_t ) ( to - from ) : 
+                    ( std::size_t ) ( this->m_map.cbegin()->first - from ) + ( std::size_t ) ( to - this->m_map.crbegin()->first ) );
+
+                if ( outside not_eq 0 )
+                    resultMap[this->m_valBegin] += outside;
+
+                return resultMap;
+            }
+        }
+
+        for ( const auto& [begin, end, value] : this->runs(from, to) )
+            resultMap[value] += ( std::size_t ) ( end - begin );
+
+        return resultMap;
+    }
+
+
+    [[nodiscard]] constexpr std::vector<std::pair<keyType, keyType>> getValueRanges
+    (
+        const valueType& value, 
+        const bool shrink = false
+    ) const
+    {
+        LOCK_READ
+
+        std::vector<std::pair<keyType, keyType>> result;
+
+        if ( value == this->m_valBegin and ( this->m_map.empty() or this->minIndex < this->m_map.cbegin()->first ) )
+            result.emplace_back(this->minIndex, this->m_map.empty() ? this->maxIndex : std::min(this->m_map.cbegin()->first, this->maxIndex));
+
+        if constexpr ( requires { this->m_map.findValueKeys(value); } )
+        {
+            if ( const auto* keys = this->m_map.findValueKeys(value); keys not_eq nullptr )
+            {
+                result.reserve(result.size() + keys->size());
+
+                for ( auto itKey = keys->cbegin(); itKey not_eq keys->cend() and *itKey < this->maxIndex; ++itKey )
+                    this->appendRunRange(result, this->m_map.find(*itKey));
+            }
+        }
+        else
+        {
+            for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend() and it->first < this->maxIndex; ++it )
+            {
+                if ( it->second == value )
+                    this->appendRunRange(result, it);
+            }
+        }
+
+        if ( shrink )
+            result.shrink_to_fit();
+
+        return result;
+    }
+
+
+    [[nodiscard]] constexpr std::unordered_map<valueType, std::vector<std::pair<keyType, keyType>>> getValuesRanges
+    (
+        const std::unordered_set<valueType>& values, 
+        const bool shrink = false
+    ) const
+    {
+        LOCK_READ
+
+        std::unordered_map<valueType, std::vector<std::pair<keyType, keyType>>> result;
+
+        if constexpr ( requires { this->m_map.findValueKeys(this->m_valBegin); } )
+        {
+            for ( const auto& value : values )
+            {
+                if ( auto ranges = this->getValueRanges(value); not ranges.empty() )
+                    result.emplace(value, std::move(ranges));
+            }
+
+            return result;
+        }
+        else
+        {
+            if ( values.contains(this->m_valBegin) and ( this->m_map.empty() or this->minIndex < this->m_map.cbegin()->first ) )
+                result[this->m_valBegin].emplace_back(this->minIndex, this->m_map.empty() ? this->maxIndex : std::min(this->m_map.cbegin()->first, this->maxIndex));
+
+            for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend() and it->first < this->maxIndex; ++it )
+            {
+                if ( values.contains(it->second) )
+                    this->appendRunRange(result[it->second], it);
+            }
+        }
+
+        if ( shrink )
+            for ( auto& [value, vector] : result )
+                vector.shrink_to_fit();
+
+        return result;
+    }
+
+
+    [[nodiscard]] constexpr valueType getMinValue(const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}) const
+    {
+        LOCK_READ
+
+        return this->getMinValue(this->minIndex, this->maxIndex, compareFunction);
+    }
+
+
+    [[nodiscard]] constexpr valueType getMinValue
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return this->m_valBegin;
+
+        valueType result { (*this)[from] };
+
+        if constexpr ( requires { this->m_map.rangeMinimum(from, to); } )
+        {
+            if ( compareFunction.template target<std::less<valueType>>() or compareFunction.template target<std::less<>>() )
+            {
+                if ( const auto nodesMinimum = this->m_map.rangeMinimum(from + keyType(1), to); nodesMinimum and *nodesMinimum < result )
+                    result = *nodesMinimum;
+
+                return result;
+            }
+        }
+
+        const auto itBegin = this->m_map.upper_bound(from);
+        const auto itEnd = this->m_map.lower_bound(to);
+
+        if ( itBegin == itEnd )
+            return result;
+
+        const valueType& nodesMinimum = std::min_element(std::execution::par_unseq, itBegin, itEnd, 
+            [&compareFunction](const auto& itA, const auto& itB) { return compareFunction(itA.second, itB.second); })->second;
+
+        return std::min(result, nodesMinimum, compareFunction);
+    }
+
+
+    [[nodiscard]] constexpr valueType getMaxValue(const std::function<bool(const valueType&, const valueType&e)>& compareFunction = std::less<valueType>{}) const
+    {
+        LOCK_READ
+
+        return this->getMaxValue(this->minIndex, this->maxIndex, compareFunction);
+    }
+
+
+    [[nodiscard]] constexpr valueType getMaxValue
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less{}
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return this->m_valBegin;
+
+        valueType result { (*this)[from] };
+
+        if constexpr ( requires { this->m_map.rangeMaximum(from, to); } )
+        {
+            if ( compareFunction.template target<std::less<valueType>>() or compareFunction.template target<std::less<>>() )
+            {
+                if ( const auto nodesMaximum = this->m_map.rangeMaximum(from + keyType(1), to); nodesMaximum and result < *nodesMaximum )
+                    result = *nodesMaximum;
+
+                return result;
+            }
+        }
+
+        const auto itBegin = this->m_map.upper_bound(from);
+        const auto itEnd = this->m_map.lower_bound(to);
+
+        if ( itBegin == itEnd )
+            return result;
+
+        const valueType& nodesMaximum = std::max_element(std::execution::par_unseq, itBegin, itEnd, 
+            [&compareFunction](const auto& itA, const auto& itB) { return compareFunction(itA.second, itB.second); })->second;
+
+        return std::max(result, nodesMaximum, compareFunction);
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getSum(const valueType& init = valueType(0)) const
+    {
+        LOCK_READ
+
+        return this->getSum(this->minIndex, this->maxIndex, init);
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getSum
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const valueType& init = valueType(0)
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return (*this)[from];
+
+        if constexpr ( requires { this->m_map.prefixSum(to); } )
+        {
+            if ( this->m_map.empty() )
+                return init + this->m_valBegin * ( valueType ) ( to - from );
+
+            const keyType firstKey = this->m_map.cbegin()->first, lastKey = this->m_map.crbegin()->first;
+
+            const keyType outside = ( from < firstKey ? std::min(to, firstKey) - from : keyType(0) ) + ( lastKey < to ? to - std::max(from, lastKey) : keyType(0) );
+
+            return init + ( this->m_map.prefixSum(to) - this->m_map.prefixSum(from) ) + this->m_valBegin * ( valueType ) outside;
+        }
+
+        if ( this->m_map.empty() or to < this->m_map.cbegin()->first or from > this->m_map.crbegin()->first )
+            return init + this->m_valBegin * (to - from);
+
+        const auto itBegin = this->m_map.lower_bound(from);
+        const auto itEnd = this->m_map.lower_bound(to);
+
+        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
+        
+        if ( itBegin == itEnd )
+            return init + (to - from) * prevItBeginVal;
+
+        valueType result { init + ( itBegin->first - from ) * prevItBeginVal };
+
+        for ( auto it = std::next(itBegin); it not_eq itEnd; ++it )
+        {
+            const auto& prevIt = std::prev(it);
+
+            result += (it->first - prevIt->first) * prevIt->second;
+        }
+
+        const auto& prevItEnd = std::prev(itEnd);
+
+        return result + (to - prevItEnd->first) * prevItEnd->second;
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getProduct(const valueType& init = valueType(1)) const
+    {
+        LOCK_READ
+
+        return this->getProduct(this->minIndex, this->maxIndex, init);
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getProduct
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const valueType& init = valueType(1)
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return (*this)[from];
+
+        if ( this->m_map.empty() or to < this->m_map.cbegin()->first or from > this->m_map.crbegin()->first )
+            return init * ( valueType ) std::pow(this->m_valBegin, (to - from));
+
+        const auto itBegin = this->m_map.lower_bound(from);
+        const auto itEnd = this->m_map.lower_bound(to);
+
+        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
+        
+        if ( itBegin == itEnd )
+            return init * ( valueType ) std::pow(prevItBeginVal, (to - from)) ;
+
+        valueType result { init * ( valueType ) std::pow(prevItBeginVal, (itBegin->first - from)) };
+
+        for ( auto it = std::next(itBegin); it not_eq itEnd; ++it )
+        {
+            const auto& prevIt = std::prev(it);
+
+            result *= ( valueType ) std::pow(prevIt->second, (it->first - prevIt->first)) ;
+        }
+
+        const auto& prevItEnd = std::prev(itEnd);
+
+        return result * ( valueType ) std::pow(prevItEnd->second, (to - prevItEnd->first));
+    }
+
+
+    template<class resultType, class reductionType>
+    [[nodiscard]] constexpr resultType reduceWithArray
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        resultType init, 
+        reductionType&& reduction
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        this->forEachRunPair(array, from, to, [&init, &reduction](const keyType& begin, const keyType& end, const valueType& thisValue, const valueType& arrayValue) 
+            { init = reduction(std::move(init), end - begin, thisValue, arrayValue); });
+
+        return init;
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType dot(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, const valueType& init = valueType(0)) const
+    {
+        LOCK_WITH(false, array, false)
+
+        return this->dot(array, this->minIndex, this->maxIndex, init);
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType dot
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        const valueType& init = valueType(0)
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        return this->reduceWithArray(array, fromArg, toArg, init, 
+            [](const valueType& result, const keyType& length, const valueType& a, const valueType& b) { return result + ( valueType ) length * a * b; });
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getL1Distance
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        return this->reduceWithArray(array, fromArg, toArg, valueType(0), 
+            [](const valueType& result, const keyType& length, const valueType& a, const valueType& b) { return result + ( valueType ) length * ( a < b ? b - a : a - b ); });
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr valueType getSquaredL2Distance
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        return this->reduceWithArray(array, fromArg, toArg, valueType(0), 
+            [](const valueType& result, const keyType& length, const valueType& a, const valueType& b) 
+            { 
+                const valueType difference = ( a < b ? b - a : a - b );
+
+                return result + ( valueType ) length * difference * difference; 
+            });
+    }
+
+
+    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
+    [[nodiscard]] constexpr double getL2Distance
+    (
+        const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        return std::sqrt(( double ) this->getSquaredL2Distance(array, fromArg, toArg));
+    }
+
+
+    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, bool>> compareWithArray
+    (
+        compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array, 
+        const keyType& fromArgLeft, 
+        const keyType& toArgLeft,
+        const keyType& fromArgRight, 
+        const keyType& toArgRight,
+        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::equal_to<valueType>{}
+    ) const
+    {
+        LOCK_WITH(false, array, false)
+
+        const auto [fromLeft, toLeft] = this->getValidRange(fromArgLeft, toArgLeft);
+        const auto [fromRight, toRight] = array.getValidRange(fromArgRight, toArgRight);
+
+        if ( fromLeft == toLeft or fromRight == toRight or ( toLeft -  fromLeft ) not_eq ( toRight - fromRight ) )
+            return {};
+
+        const auto valuesLeft = this->getValues(fromLeft, toLeft);
+        const auto valuesRight = array.getValues(fromRight, toRight);
+        // TODO
+    }
+
+
+    [[nodiscard]] constexpr std::vector<valueType> uncompressToVector(void) const
+    {
+        LOCK_READ
+
+        return this->uncompressToVector(this->minIndex, this->maxIndex);
+    }
+
+
+    [[nodiscard]] constexpr std::vector<valueType> uncompressToVector
+    (
+        const keyType& fromArg, 
+        const keyType& toArg
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return {};
+
+        const auto length = ( std::size_t ) std::llround(std::ceil(to - from));
+
+        if ( constexpr std::vector<valueType> temp; length > temp.max_size() )
+            return {};
+
+        if ( this->m_map.empty() )
+            return std::vector<valueType>(length , this->m_valBegin );
+
+        const auto& itBegin = this->m_map.lower_bound(from);
+        const auto& itEnd = this->m_map.lower_bound(to);
+
+        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
+            return std::vector<valueType>(length, this->m_valBegin );
+
+        if ( itBegin == itEnd )
+            return std::vector<valueType>(length, std::prev(itBegin)->second );
+
+        std::vector<valueType> result;
+        result.resize(length);
+
+        std::size_t size { ( std::size_t ) std::llround(std::ceil(itBegin->first - from)) };
+
+        auto itResult = result.begin();
+
+        std::fill_n(std::execution::par_unseq, itResult, size, itBegin not_eq this->m_map.cbegin() ? std::prev(itBegin)->second : this->m_valBegin);
+
+        std::advance(itResult, size);
+
+        for ( auto it = std::next(itBegin) ; it not_eq itEnd ; ++it )
+        {
+            size = ( std::size_t ) ( std::llround(std::ceil(it->first - std::prev(it)->first)) );
+
+            std::fill_n(std::execution::par_unseq, itResult, size, std::prev(it)->second);
+
+            std::advance(itResult, size);
+        }
+
+        std::fill_n(std::execution::par_unseq, itResult, ( std::size_t ) ( std::llround(std::ceil(to - std::prev(itEnd)->first)) ), std::prev(itEnd)->second);
+
+        return result;
+    }
+
+
+    void print
+    (
+        bool uncopressed = false, 
+        std::ostream& os = std::cout, 
+        const bool newLine = true, 
+        const short prec = 3
+    ) const
+    {
+        LOCK_READ
+
+        this->print(this->minIndex, this->maxIndex, uncopressed, os, newLine, prec);
+    }
+
+
+    void print
+    (
+        const keyType& fromArg, 
+        const keyType& toArg, 
+        bool uncopressed = false, 
+        std::ostream& os = std::cout, 
+        const bool newLine = true, 
+        const short prec = 3
+    ) const
+    {
+        LOCK_READ
+
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
+
+        if ( from == to )
+            return;
+
+        const auto currPrec = os.precision();
+
+        constexpr bool isFloating = std::is_floating_point_v<keyType> or std::is_floating_point_v<valueType>;
+
+        if constexpr ( isFloating )
+            os.precision(prec);
+
+        if ( newLine )
+            os << "\n";
+
+        if ( uncopressed )
+        {
+            for ( const auto item : uncompressToVector(from, to) )
+                os << item << " ";
+
+            os.flush();
+
+            if constexpr ( isFloating )
+                os.precision(currPrec);
+
+            return;
+        }
+
+        os << from << " | ";
+
+        bool first { true };
+
+        for ( const auto& [begin, end, value] : this->runs(from, to) )
+        {
+            os << ( first ? "(" : ", (" ) << value << ", " << end - begin << ")";
+
+            first = false;
+        }
+
+        os << " | " << to;
+
+        os.flush();
+
+        if constexpr ( isFloating )
+            os.precision(currPrec);
+    }
+
+
+    friend std::ostream& operator<<(std::ostream& os, const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& array)
+    {
+        array.print(array.getMinIndex(), array.getMaxIndex(), false, os);
+
+        return os;
+    }
+
+
+    [[maybe_unused]] bool toFile
+    (
+        std::string_view filePath, 
+        const keyType& from, 
+        const keyType& to, 
+        bool append = false, 
+        bool uncopressed = false, 
+        bool trimEdges = true, const short prec = 3
+    ) const
+    {
+        LOCK_READ
+
+        std::ofstream ostrm(filePath, append ? std::ios::app : std::ios::out);
+
+        if ( not ostrm.is_open() )
+            return false;
+
+        this->print(from, to, uncopressed, ostrm, trimEdges, false, prec);
+
+        return true;
+    }
+
+
+    [[nodiscard]] static constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compress
+    (
+        const std::span<const valueType> buffer, 
+        keyType startIndex = keyType(0), 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr,
+        const bool bitwiseEquality = false
+    )
+    {
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        appendRunNodes(nodes, buffer, startIndex, initValue, bitwiseEquality);
+
+        return fromRunNodes(nodes, startIndex, buffer.size(), initValue, ratio, bitwiseEquality);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressParallel
+    (
+        const std::span<const valueType> buffer, 
+        keyType startIndex = keyType(0), 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr,
+        const bool bitwiseEquality = false,
+        std::size_t chunkCount = 0
+    )
+    {
+        constexpr std::size_t minChunkSize { std::size_t(1) << 16 };
+
+        if ( chunkCount == 0 )
+            chunkCount = std::max(1u, std::thread::hardware_concurrency());
+
+        chunkCount = std::min(chunkCount, buffer.size() / minChunkSize);
+
+        if ( chunkCount < 2 )
+            return compress(buffer, startIndex, initValue, ratio, bitwiseEquality);
+
+        std::vector<std::vector<std::pair<keyType, valueType>>> chunkNodes(chunkCount);
+
+        std::vector<std::size_t> chunks(chunkCount);
+
+        std::iota(chunks.begin(), chunks.end(), std::size_t(0));
+
+        std::for_each(std::execution::par, chunks.cbegin(), chunks.cend(), [&](const std::size_t chunk)
+        {
+            // Each chunk starts one element early, so a boundary on its first element is found without stitching.
+            const std::size_t first { buffer.size() * chunk / chunkCount - ( chunk ? 1 : 0 ) }, end { buffer.size() * ( chunk + 1 ) / chunkCount };
+
+            compressedVectorRunEncoder<valueType>::forEachRunBoundary(buffer.subspan(first, end - first), bitwiseEquality, [&, &nodes = chunkNodes[chunk]](const std::size_t index) 
+            { 
+                nodes.emplace_back(startIndex + ( keyType ) ( first + index ), buffer[first + index]); 
+            });
+        });
+
+        std::vector<std::size_t> offsets(chunkCount + 1, 0);
+
+        offsets.front() = isSameRunValue(buffer.front(), initValue, bitwiseEquality) ? 0 : 1;
+
+        for ( std::size_t chunk = 0; chunk < chunkCount; ++chunk )
+            offsets[chunk + 1] = offsets[chunk] + chunkNodes[chunk].size();
+
+        std::vector<std::pair<keyType, valueType>> nodes(offsets.back());
+
+        if ( offsets.front() )
+            nodes.front() = { startIndex, buffer.front() };
+
+        std::for_each(std::execution::par, chunks.cbegin(), chunks.cend(), [&](const std::size_t chunk)
+        {
+            std::ranges::copy(chunkNodes[chunk], nodes.begin() + ( std::ptrdiff_t ) offsets[chunk]);
+
+            std::vector<std::pair<keyType, valueType>>{}.swap(chunkNodes[chunk]);
+        });
+
+        return fromRunNodes(nodes, startIndex, buffer.size(), initValue, ratio, bitwiseEquality);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressFromFile
+    (
+        std::string_view filePath, 
+        const std::size_t indexFromStart = 0, 
+        const std::size_t indexFromEnd = 0, 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr
+    )
+    {
+        const compressedVectorMappedFile file { filePath };
+
+        if ( not file.isOpen() )
+            return {};
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        std::size_t total { 0 };
+
+        valueType previous { initValue };
+
+        forEachParsedValue(file.getText(), [&](const valueType& value)
+        {
+            if ( total >= indexFromStart )
+            {
+                const std::size_t position { total - indexFromStart };
+
+                if ( not isSameRunValue(value, position == 0 ? initValue : previous, false) )
+                    nodes.emplace_back(( keyType ) position, value);
+
+                previous = value;
+            }
+
+            ++total;
+
+            return true;
+        });
+
+        if ( total == 0 or indexFromStart + indexFromEnd > total )
+            return {};
+
+        const std::size_t length { total - indexFromStart - indexFromEnd };
+
+        while ( not nodes.empty() and ( std::size_t ) nodes.back().first >= length )
+            nodes.pop_back();
+
+        return fromRunNodes(nodes, keyType(0), length, initValue, ratio, false);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressFromFileParts
+    (
+        std::string_view filePath,
+        const std::vector<std::pair<const std::size_t, const std::size_t>>& ranges,
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr
+    )
+    {
+        if ( ranges.empty() )
+            return {};
+
+        const compressedVectorMappedFile file { filePath };
+
+        if ( not file.isOpen() )
+            return {};
+
+        const compressedVectorTextIndex index { compressedVectorTextIndex::forFile(filePath, file.getText()) };
+
+        const std::size_t total { index.getCount() };
+
+        if ( total == 0 )
+            return {};
+
+        std::vector<std::pair<std::size_t, std::size_t>> rangesFixedTemp, rangesFixed;
+        rangesFixedTemp.reserve(ranges.size());
+        rangesFixed.reserve(ranges.size());
+
+        std::copy_if(ranges.begin(), ranges.end(), std::back_inserter(rangesFixedTemp), [&total](const auto& p) { return p.first < p.second and p.second <= total; });
+
+        if ( rangesFixedTemp.empty() )
+            return {};
+
+        std::sort(rangesFixedTemp.begin(), rangesFixedTemp.end());
+
+        rangesFixed.emplace_back(rangesFixedTemp.front());
+
+        for ( auto it = std::next(rangesFixedTemp.cbegin()); it not_eq rangesFixedTemp.cend(); ++it )
+            if ( it->first >= rangesFixed.back().second )
+                rangesFixed.emplace_back(*it);
+
+        rangesFixedTemp.clear();
+
+        std::vector<std::vector<std::pair<keyType, valueType>>> partNodes(rangesFixed.size());
+
+        std::vector<std::size_t> parts(rangesFixed.size()), partSizes(rangesFixed.size() + 1, 0);
+
+        std::iota(parts.begin(), parts.end(), std::size_t(0));
+
+        std::for_each(std::execution::par, parts.cbegin(), parts.cend(), [&](const std::size_t part)
+        {
+            const auto [from, to] = rangesFixed[part];
+
+            auto& nodes { partNodes[part] };
+
+            std::size_t& size { partSizes[part + 1] };
+
+            forEachParsedValue(index.seek(file.getText(), from), [&nodes, &size, &from, &to](const valueType& value)
+            {
+                if ( nodes.empty() or not isSameRunValue(value, nodes.back().second, false) )
+                    nodes.emplace_back(( keyType ) size, value);
+
+                return ++size < to - from;
+            });
+        });
+
+        std::partial_sum(partSizes.cbegin(), partSizes.cend(), partSizes.begin());
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        for ( std::size_t part = 0; part < parts.size(); ++part )
+            for ( const auto& [key, value] : partNodes[part] )
+                if ( not isSameRunValue(value, nodes.empty() ? initValue : nodes.back().second, false) )
+                    nodes.emplace_back(key + ( keyType ) partSizes[part], value);
+
+        return fromRunNodes(nodes, keyType(0), partSizes.back(), initValue, ratio, false);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressFromBinaryFile
+    (
+        std::string_view filePath, 
+        const std::size_t offset = 0, 
+        const std::size_t count = std::numeric_limits<std::size_t>::max(), 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr, 
+        const bool bitwiseEquality = false
+    )
+    {
+        const compressedVectorMappedFile file { filePath };
+
+        if ( not file.isOpen() )
+            return {};
+
+        const std::size_t available { file.getBytes().size() / sizeof(valueType) }, from { std::min(offset, available) }, length { std::min(count, available - from) };
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        keyType position { 0 };
+
+        valueType previous { initValue };
+
+        appendBinaryRunNodes(nodes, file.getBytes().subspan(from * sizeof(valueType), length * sizeof(valueType)), position, previous, bitwiseEquality);
+
+        return fromRunNodes(nodes, keyType(0), length, initValue, ratio, bitwiseEquality);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressFromBinaryFiles
+    (
+        const std::vector<std::string_view>& filePaths, 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr, 
+        const bool bitwiseEquality = false
+    )
+    {
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        keyType position { 0 };
+
+        valueType previous { initValue };
+
+        for ( const auto filePath : filePaths )
+        {
+            const compressedVectorMappedFile file { filePath };
+
+            if ( not file.isOpen() )
+                return {};
+
+            appendBinaryRunNodes(nodes, file.getBytes(), position, previous, bitwiseEquality);
+        }
+
+        return fromRunNodes(nodes, keyType(0), ( std::size_t ) position, initValue, ratio, bitwiseEquality);
+    }
+
+
+    [[nodiscard]] static compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType> compressFromBinaryStream
+    (
+        std::istream& stream, 
+        const std::size_t count = std::numeric_limits<std::size_t>::max(), 
+        const valueType& initValue = valueType(0), 
+        double* ratio = nullptr, 
+        const bool bitwiseEquality = false
+    )
+    {
+        constexpr std::size_t blockSize { ( std::size_t(1) << 20 ) / sizeof(valueType) };
+
+        std::vector<valueType> block(blockSize);
+
+        std::vector<std::pair<keyType, valueType>> nodes;
+
+        keyType position { 0 };
+
+        valueType previous { initValue };
+
+        std::size_t length { 0 }, pending { 0 };
+
+        while ( length < count and stream )
+        {
+            const std::size_t wanted { std::min(blockSize, count - length) * sizeof(valueType) };
+
+            stream.read(( char* ) block.data() + pending, ( std::streamsize ) ( wanted - pending ));
+
+            const std::size_t bytes { pending + ( std::size_t ) stream.gcount() }, values { bytes / sizeof(valueType) };
+
+            appendBinaryRunNodes(nodes, std::as_bytes(std::span{ block }).first(values * sizeof(valueType)), position, previous, bitwiseEquality);
+
+            length += values;
+
+            pending = bytes - values * sizeof(valueType);
+
+            std::memmove(block.data(), ( const char* ) block.data() + values * sizeof(valueType), pending);
+        }
+
+        return fromRunNodes(nodes, keyType(0), length, initValue, ratio, bitwiseEquality);
+    }
+
+
+    [[nodiscard]] bool mapCanonicalValidationDebug(void) const 
+    {
+        LOCK_READ
+
+        return 
+        this->m_map.size() not_eq 1
+        and 
+        ( this->m_map.empty() or ( this->m_valBegin == this->m_map.crbegin()->second and this->m_valBegin not_eq this->m_map.cbegin()->second ) )
+        and
+        std::adjacent_find(std::execution::par_unseq, this->m_map.cbegin(), this->m_map.cend(), 
+            [](const auto& a, const auto& b){ return a.second == b.second; }) == this->m_map.cend();
+    }
+
+
+    void printMapDebug(void) const
+    {
+        LOCK_READ
+
+        std::cout << std::endl;
+
+        if ( this-> m_map.empty() )
+            std::cout << "Map is empty.";
+
+        for ( const auto& [key, value] : this->m_map )
+            std::cout << "(" << key << ", " << value << "), ";
+    }
+};
+
+
+template<class vectorType>
+class compressedVectorView
+{
+    using keyType = typename vectorType::key_type;
+
+    using valueType = typename vectorType::value_type;
+
+    const vectorType* m_vector;
+
+    keyType m_from, m_to;
+
+public:
+
+    using key_type = keyType;
+
+    using value_type = valueType;
+
+    using const_iterator = typename vectorType::const_iterator;
+
+    using iterator = const_iterator;
+
+    using const_reverse_iterator = typename vectorType::const_reverse_iterator;
+
+    using reverse_iterator = const_reverse_iterator;
+
+    using run_iterator = typename vectorType::run_iterator;
+
+
+    constexpr compressedVectorView(const vectorType& vector, const keyType& fromArg, const keyType& toArg): m_vector{ &vector }, m_from{}, m_to{}
+    {
+        std::tie(this->m_from, this->m_to) = vector.getValidRange(fromArg, toArg);
+    }
+
+
+    [[nodiscard]] constexpr const vectorType& getVector(void) const noexcept 
+    { 
+        return *this->m_vector; 
+    }
+
+
+    [[nodiscard]] constexpr keyType getMinIndex(void) const noexcept 
+    { 
+        return this->m_from; 
+    }
 
-            it = this->m_map.emplace_hint(it, position, valuesIt->first);
-        }
-        /* Maybe not needed */
-        if ( ( not this->m_map.empty() ) and this->m_map.crbegin()->second not_eq this->m_valBegin )
-            this->m_map.emplace_hint(this->m_map.cend(), position, this->m_valBegin);
-        /* Maybe not needed */
-        if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
-            this->m_map.erase(this->m_map.cbegin());
+
+    [[nodiscard]] constexpr keyType getMaxIndex(void) const noexcept 
+    { 
+        return this->m_to; 
     }
 
 
-    constexpr void assignRangeFromArray
-    (
-        compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& array, 
-        const keyType& fromA, 
-        const keyType& toA,
-        const keyType& fromB, 
-        const keyType& toB
-    )
+    [[nodiscard]] constexpr std::pair<keyType, keyType> getMinMaxIndex(void) const noexcept
     {
-        // TODO
+        return { this->m_from, this->m_to };
     }
 
 
-    constexpr void swapRangesWithArray
-    (
-        const keyType& fromA, 
-        const keyType& toA, 
-        compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& array, 
-        const keyType& fromB, 
-        const keyType& toB
-    )
+    [[nodiscard]] constexpr auto getLength(void) const noexcept
     {
-        // TODO
+        return ( std::size_t ) ( this->m_to - this->m_from );
     }
 
 
-    constexpr void swapRanges
-    (
-        const keyType& fromA, 
-        const keyType& toA, 
-        const keyType& fromB, 
-        const keyType& toB
-    )
+    [[nodiscard]] constexpr bool empty(void) const noexcept
     {
-        // TODO
+        return this->m_from == this->m_to;
     }
 
 
-    constexpr void copyRange
+    [[nodiscard]] constexpr std::pair<keyType, keyType> getValidRange
     (
-        const keyType& fromA, 
-        const keyType& toA, 
-        const keyType& fromB, 
-        const keyType& toB
-    )
+        const keyType& from, 
+        const keyType& to
+    ) const
     {
-        // TODO
+        if ( to <= from )
+            return { from, from };
+
+        return { std::clamp(from, this->m_from, this->m_to), std::clamp(to, this->m_from, this->m_to) };
     }
 
 
-    constexpr void insertValuesAfterPosition
-    (
-        const keyType& position, 
-        const std::vector<std::pair<valueType, std::size_t>>& values,
-        const bool expandLeft = false
-    )
+    [[nodiscard]] constexpr compressedVectorView<vectorType> view(const keyType& fromArg, const keyType& toArg) const
     {
-        if ( position < this->minIndex or position >= this->maxIndex or values.empty() )
-            return;
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
 
-        std::vector<std::pair<valueType, std::size_t>> fixedValues = { values.front() };
+        return { *this->m_vector, from, to };
+    }
 
-        std::size_t size { fixedValues.front().second };
 
-        for ( auto it = std::next(values.cbegin()) ; it not_eq values.cend() ; ++it )
-        {
-            if ( it->first not_eq fixedValues.back().first )
-            {
-                if ( it->second )
-                    fixedValues.push_back(*it);
-            }
+    // Keys are the vector's own keys, as everywhere else in the view: view[getMinIndex()] is its first element.
+    [[nodiscard]] constexpr decltype(auto) operator[](const keyType& key) const 
+    { 
+        assert(key >= this->m_from and key < this->m_to);
 
-            else
-                fixedValues.back().second += it->second;
+        return (*this->m_vector)[key]; 
+    }
 
-            size += it->second;
-        }
 
-        if ( this->m_map.empty() )
-        {
-            if ( fixedValues.back().first == this->m_valBegin )
-                fixedValues.pop_back();
+    [[nodiscard]] constexpr decltype(auto) at(const keyType& key) const
+    {
+        if ( key < this->m_from or key >= this->m_to )
+            throw std::out_of_range("compressedVectorView::at: key is outside the view");
 
-            auto index = position + 1 + ( expandLeft ? ( keyType ) -size : 0 );
+        return (*this->m_vector)[key];
+    }
 
-            for ( const auto& [value, freq] : fixedValues )
-            {
-                this->m_map.emplace_hint(this->m_map.cend(), index, value);
 
-                index += ( keyType ) freq;
-            }
+    [[nodiscard]] constexpr const_iterator begin(void) const { return this->m_vector->elements(this->m_from, this->m_to).begin(); }
 
-            this->m_map.emplace_hint(this->m_map.cend(), index, this->m_valBegin);
+    [[nodiscard]] constexpr const_iterator end(void) const { return this->m_vector->elements(this->m_from, this->m_to).end(); }
 
-            if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
-                this->m_map.erase(this->m_map.cbegin());
+    [[nodiscard]] constexpr const_iterator cbegin(void) const { return this->begin(); }
 
-            if ( expandLeft )
-                this->minIndex -= ( keyType ) size;
+    [[nodiscard]] constexpr const_iterator cend(void) const { return this->end(); }
 
-            else
-                this->maxIndex += ( keyType ) size;
+    [[nodiscard]] constexpr const_reverse_iterator rbegin(void) const { return const_reverse_iterator{ this->end() }; }
 
-            return;
-        }
+    [[nodiscard]] constexpr const_reverse_iterator rend(void) const { return const_reverse_iterator{ this->begin() }; }
 
-        auto itPosition = this->m_map.upper_bound(position);
+    [[nodiscard]] constexpr const_reverse_iterator crbegin(void) const { return this->rbegin(); }
 
-        const auto nextKey = itPosition->first;
+    [[nodiscard]] constexpr const_reverse_iterator crend(void) const { return this->rend(); }
 
-        auto prevVal = ( itPosition == this->m_map.cbegin() ? this->m_valBegin : std::prev(itPosition)->second );
 
-        std::vector<typename decltype(this->m_map)::node_type> shifted;
+    [[nodiscard]] constexpr auto runs(void) const
+    {
+        return this->m_vector->runs(this->m_from, this->m_to);
+    }
 
-        if ( expandLeft )
-        {
-            for ( auto it = this->m_map.begin(); it not_eq itPosition; )
-            {
-                shifted.push_back(this->m_map.extract(it++));
 
-                shifted.back().key() -= ( keyType ) size;
-            }
+    [[nodiscard]] constexpr bool contains(const valueType& value) const
+    {
+        return this->m_vector->contains(this->m_from, this->m_to, value);
+    }
 
-            auto index = position + 1 - ( keyType ) size;
 
-            auto itNew = fixedValues.begin();
+    [[nodiscard]] constexpr valueType getSum(const valueType& init = valueType(0)) const
+    {
+        return this->m_vector->getSum(this->m_from, this->m_to, init);
+    }
 
-            if ( itNew->first == prevVal )
-                index += ( keyType ) (itNew++)->second;
 
-            for ( ; itNew not_eq fixedValues.cend(); ++itNew )
-            {
-                this->m_map.emplace_hint(itPosition, index, itNew->first);
+    [[nodiscard]] constexpr valueType getProduct(const valueType& init = valueType(1)) const
+    {
+        return this->m_vector->getProduct(this->m_from, this->m_to, init);
+    }
 
-                index += ( keyType ) itNew->second;
-            }
 
-            if ( std::prev(itPosition)->second not_eq prevVal and nextKey - position > 1 )
-                this->m_map.emplace_hint(itPosition, index, prevVal);
+    [[nodiscard]] constexpr valueType getMinValue(const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}) const
+    {
+        return this->m_vector->getMinValue(this->m_from, this->m_to, compareFunction);
+    }
 
-            else if ( itPosition->second == fixedValues.back().first )
-                this->m_map.erase(itPosition);
 
-            itPosition = this->m_map.begin();
+    [[nodiscard]] constexpr valueType getMaxValue(const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}) const
+    {
+        return this->m_vector->getMaxValue(this->m_from, this->m_to, compareFunction);
+    }
 
-            if ( not shifted.empty() )
-                for ( auto it = ( shifted.crbegin()->mapped() == itPosition->second ? std::next(shifted.rbegin()) : shifted.rbegin() ) ; it not_eq shifted.crend(); ++it )
-                    this->m_map.insert(itPosition, std::move(*it));
 
-            else if ( this->m_map.cbegin()->second == this->m_valBegin )
-                this->m_map.erase(this->m_map.cbegin());
+    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, valueType>> getValues(const bool shrink = false) const
+    {
+        return this->m_vector->getValues(this->m_from, this->m_to, shrink);
+    }
 
-            if ( this->m_map.crbegin()->second not_eq this->m_valBegin )
-                this->m_map.emplace_hint(this->m_map.cend(), index, this->m_valBegin);
 
-            this->minIndex -= ( keyType ) size;
-        }
+    [[nodiscard]] constexpr std::map<valueType, std::size_t> getRangeValueFrequencies(void) const
+    {
+        return this->m_vector->getRangeValueFrequencies(this->m_from, this->m_to);
+    }
 
-        else
-        {
-            for ( auto it = itPosition; it not_eq this->m_map.cend(); )
-            {
-                shifted.push_back(this->m_map.extract(it++));
 
-                shifted.back().key() += ( keyType ) size;
-            }
+    [[nodiscard]] constexpr std::vector<valueType> uncompressToVector(void) const
+    {
+        return this->m_vector->uncompressToVector(this->m_from, this->m_to);
+    }
 
-            auto index = position + 1;
 
-            auto itNew = fixedValues.begin();
+    [[nodiscard]] constexpr vectorType toVector(void) const
+    {
+        return this->m_vector->getSubArray(this->m_from, this->m_to);
+    }
 
-            if ( itNew->first == prevVal )
-                index += ( keyType ) (itNew++)->second;
 
-            for ( ; itNew not_eq fixedValues.cend(); ++itNew )
-            {
-                this->m_map.emplace_hint(this->m_map.cend(), index, itNew->first);
+    void print
+    (
+        bool uncopressed = false, 
+        std::ostream& os = std::cout, 
+        const bool newLine = true, 
+        const short prec = 3
+    ) const
+    {
+        this->m_vector->print(this->m_from, this->m_to, uncopressed, os, newLine, prec);
+    }
 
-                index += ( keyType ) itNew->second;
-            }
 
-            if ( this->m_map.crbegin()->second not_eq prevVal and nextKey - position > 1 )
-                this->m_map.emplace_hint(this->m_map.cend(), index, prevVal);
+    friend std::ostream& operator<<(std::ostream& os, const compressedVectorView<vectorType>& view)
+    {
+        view.print(false, os);
 
-            if ( not shifted.empty() )
-                for ( auto it = ( shifted.cbegin()->mapped() == this->m_map.crbegin()->second ? std::next(shifted.begin()) : shifted.begin()); it not_eq shifted.cend(); ++it )
-                    this->m_map.insert(this->m_map.cend(), std::move(*it));
+        return os;
+    }
+};
 
-            else if ( this->m_map.crbegin()->second not_eq this->m_valBegin )
-                this->m_map.emplace_hint(this->m_map.cend(), index, this->m_valBegin);
 
-            this->maxIndex += ( keyType ) size;
-        }
-    }
+class compressedVectorEpochDomain
+{
+    static constexpr std::size_t maxThreads { 256 };
 
+    struct alignas(64) slot
+    {
+        std::atomic<std::uint64_t> epoch { 0 };
 
-    constexpr void appendValues
-    (
-        const std::vector<std::pair<valueType, std::size_t>>& values, 
-        const bool expandLeft = false
-    )
+        std::atomic<bool> used { false };
+    };
+
+    struct participant
     {
-        if ( expandLeft )
-        {
-            const auto prevMinIndex = this->minIndex;
+        std::size_t index { maxThreads };
 
-            this->minIndex = std::ranges::fold_left(values, this->minIndex, [](const keyType& left, const auto& right){ return left - ( keyType ) right.second; });
+        std::size_t depth { 0 };
 
-            const auto insertedSize = prevMinIndex - this->minIndex;
+        std::optional<std::multiset<std::uint64_t>::iterator> overflowEntry;
 
-            std::vector<typename decltype(this->m_map)::node_type> nodes;
-            nodes.reserve(this->m_map.size());
 
-            for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); )
-            {
-                nodes.push_back(this->m_map.extract(it++));
+        ~participant()
+        {
+            if ( this->index not_eq maxThreads )
+                compressedVectorEpochDomain::slots[this->index].used.store(false, std::memory_order_release);
+        }
+    };
 
-                nodes.back().key() -= insertedSize;
-            }
+    static std::array<slot, maxThreads> slots;
 
-            for ( auto& node : nodes )
-                this->m_map.insert(this->m_map.cend(), std::move(node));
+    static std::atomic<std::uint64_t> globalEpoch;
 
-            this->assignValues(this->maxIndex - insertedSize, this->maxIndex, values);
+    static thread_local participant self;
 
-            return;
-        }
+    static std::mutex overflowMutex;
 
-        const auto prevMaxIndex = this->maxIndex;
+    // Epochs of readers that found every slot taken; they register under overflowMutex instead of waiting for a slot.
+    static std::multiset<std::uint64_t> overflowEpochs;
 
-        this->maxIndex = std::ranges::fold_left(values, this->maxIndex, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; });
 
-        this->assignValues(prevMaxIndex, this->maxIndex, values);
+    [[nodiscard]] static std::size_t claimSlot(void)
+    {
+        for ( std::size_t index = 0 ; index < maxThreads ; ++index )
+            if ( bool expected { false }; not slots[index].used.load(std::memory_order_relaxed) and slots[index].used.compare_exchange_strong(expected, true) )
+                return index;
+
+        return maxThreads;
     }
 
+public:
 
-    constexpr void prependValues
-    (
-        const std::vector<std::pair<valueType, std::size_t>>& values, 
-        const bool expandLeft = false
-    )
+    static void enter(void)
     {
-        if ( expandLeft )
-        {
-            const auto prevMinIndex = this->minIndex;
+        if ( self.depth++ not_eq 0 )
+            return;
 
-            this->minIndex = std::ranges::fold_left(values, this->minIndex, [](const keyType& left, const auto& right){ return left - ( keyType ) right.second; });
+        if ( self.index == maxThreads )
+            self.index = claimSlot();
 
-            this->assignValues(this->minIndex, prevMinIndex, values);
+        if ( self.index == maxThreads )
+        {
+            const std::scoped_lock lock { overflowMutex };
+
+            self.overflowEntry = overflowEpochs.insert(globalEpoch.load(std::memory_order_seq_cst));
 
             return;
         }
 
-        const auto prevMaxIndex = this->maxIndex;
-
-        this->maxIndex = std::ranges::fold_left(values, this->maxIndex, [](const keyType& left, const auto& right){ return left + ( keyType ) right.second; });
+        slots[self.index].epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
 
-        const auto insertedSize = this->maxIndex - prevMaxIndex;
 
-        std::vector<typename decltype(this->m_map)::node_type> nodes;
-        nodes.reserve(this->m_map.size());
+    static void exit(void)
+    {
+        if ( --self.depth not_eq 0 )
+            return;
 
-        for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); )
+        if ( self.overflowEntry )
         {
-            nodes.push_back(this->m_map.extract(it++));
+            const std::scoped_lock lock { overflowMutex };
 
-            nodes.back().key() += insertedSize;
-        }
+            overflowEpochs.erase(*self.overflowEntry);
 
-        for ( auto& node : nodes )
-            this->m_map.insert(this->m_map.cend(), std::move(node));
+            self.overflowEntry.reset();
+        }
 
-        this->assignValues(this->minIndex, this->minIndex + insertedSize, values);
+        else
+            slots[self.index].epoch.store(0, std::memory_order_release);
     }
 
 
-    constexpr void erase
-    (
-        const keyType& fromArg, 
-        const keyType& toArg,
-        const bool shrinkRight = false
-    )
+    [[nodiscard]] static std::uint64_t advance(void)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        return globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+    }
 
-        if ( from == to ) 
-            return;
 
-        const auto difference = to - from;
+    [[nodiscard]] static std::uint64_t oldestActive(void)
+    {
+        std::uint64_t oldest { std::numeric_limits<std::uint64_t>::max() };
 
-        auto itBegin = this->m_map.lower_bound(from);
-        auto itEnd = this->m_map.lower_bound(to);
+        for ( const auto& current : slots )
+            if ( const std::uint64_t epoch { current.epoch.load(std::memory_order_seq_cst) }; epoch not_eq 0 )
+                oldest = std::min(oldest, epoch);
 
-        std::vector<typename decltype(this->m_map)::node_type> shifted;
-        shifted.reserve(std::distance(itBegin, itEnd));
+        const std::scoped_lock lock { overflowMutex };
 
-        const auto prevItEndValue = ( itEnd not_eq this->m_map.cbegin() ? std::prev(itEnd)->second : this->m_valBegin );
+        return overflowEpochs.empty() ? oldest : std::min(oldest, *overflowEpochs.cbegin());
+    }
+};
 
-        this->m_map.erase(itBegin, itEnd);
 
-        if ( itBegin not_eq itEnd and itEnd not_eq this->m_map.cend() and to not_eq itEnd->first and prevItEndValue not_eq itEnd->second )
-            this->m_map.emplace_hint(itEnd, to - difference, prevItEndValue);
+inline std::array<compressedVectorEpochDomain::slot, compressedVectorEpochDomain::maxThreads> compressedVectorEpochDomain::slots {};
 
-        if ( shrinkRight )
-        {
-            for ( auto it = this->m_map.cbegin(); it not_eq itEnd; )
-            {
-                auto node = this->m_map.extract(it++);
+inline std::atomic<std::uint64_t> compressedVectorEpochDomain::globalEpoch { 1 };
 
-                node.key() += difference;
+inline std::mutex compressedVectorEpochDomain::overflowMutex {};
 
-                shifted.push_back(std::move(node));
-            }
+inline std::multiset<std::uint64_t> compressedVectorEpochDomain::overflowEpochs {};
 
-            if ( not shifted.empty() )
-            {
-                for ( auto& node : shifted )
-                    this->m_map.insert(itEnd, std::move(node));
+inline thread_local compressedVectorEpochDomain::participant compressedVectorEpochDomain::self {};
 
-                if ( itEnd not_eq this->m_map.cend() and itEnd->second == std::prev(itEnd)->second )
-                    this->m_map.erase(itEnd);
-            }
 
-            this->minIndex += difference;
-        }
+template<class vectorType>
+class rcuCompressedVector
+{
+    using keyType = typename vectorType::key_type;
 
-        else
-        {
-            for ( auto it = itEnd; it not_eq this->m_map.cend(); )
-            {
-                auto node = this->m_map.extract(it++);
+    using valueType = typename vectorType::value_type;
 
-                node.key() -= difference;
+    std::atomic<const vectorType*> m_current;
 
-                shifted.push_back(std::move(node));
-            }
+    std::mutex m_writerMutex;
 
-            if ( not shifted.empty() )
-            {
-                const auto& lastValue = ( this->m_map.empty() ? this->m_valBegin : this->m_map.crbegin()->second );
+    std::vector<std::pair<std::uint64_t, const vectorType*>> m_retired;
 
-                for ( auto it = ( shifted.cbegin()->mapped() not_eq lastValue ? shifted.begin() : std::next(shifted.begin()) ); it not_eq shifted.cend(); ++it )
-                    this->m_map.insert(this->m_map.cend(), std::move(*it));
-            }
 
-            this->maxIndex -= difference;
-        }
+    void publish(std::unique_ptr<vectorType> next)
+    {
+        const vectorType* previous { this->m_current.exchange(next.release(), std::memory_order_seq_cst) };
 
-        if ( ( not this->m_map.empty() ) and this->m_map.cbegin()->second == this->m_valBegin )
-            this->m_map.erase(this->m_map.cbegin());
+        this->m_retired.emplace_back(compressedVectorEpochDomain::advance(), previous);
 
-        if ( ( not this->m_map.empty() ) and this->m_map.crbegin()->second not_eq this->m_valBegin )
-            this->m_map.emplace_hint(this->m_map.cend(), from, this->m_valBegin);
+        this->reclaimRetired();
     }
 
 
-    constexpr void increaseValueRange
-    (
-        const keyType& from, 
-        const keyType& to, 
-        const valueType& value, 
-        const std::size_t amount,
-        const bool expandLeft = false
-    )
+    void reclaimRetired(void)
     {
-        // TODO
-    }
+        const std::uint64_t oldest { compressedVectorEpochDomain::oldestActive() };
 
+        std::erase_if(this->m_retired, [&oldest](const auto& retired) 
+        { 
+            if ( retired.first >= oldest )
+                return false;
 
-    constexpr void decreaseValueRange
-    (
-        const keyType& from, 
-        const keyType& to, 
-        const valueType& value, 
-        const std::size_t amount,
-        const bool shrinkRight = false
-    )
-    {
-        // TODO
-    }
-
+            delete retired.second;
 
-    constexpr void changeValueRange
-    (
-        const keyType& from, 
-        const keyType& to, 
-        const valueType& value, 
-        const std::size_t newRange
-    )
-    {
-        // TODO
+            return true;
+        });
     }
 
+public:
+
+    using key_type = keyType;
 
-    constexpr void shiftLeft(const keyType& difference = keyType(1))
+    using value_type = valueType;
+
+
+    class readGuard
     {
-        std::vector<typename decltype(this->m_map)::node_type> nodes;
-        nodes.reserve(this->m_map.size());
+        const vectorType* m_vector;
 
-        for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); )
+    public:
+
+        explicit readGuard(const std::atomic<const vectorType*>& current)
         {
-            nodes.push_back(this->m_map.extract(it++));
+            compressedVectorEpochDomain::enter();
 
-            nodes.back().key() -= difference;
+            this->m_vector = current.load(std::memory_order_seq_cst);
         }
 
-        for ( auto& node : nodes )
-            this->m_map.insert(this->m_map.cend(), std::move(node));
 
-        this->minIndex -= difference;
+        readGuard(const readGuard&) = delete;
 
-        this->maxIndex -= difference;
-    }
+        readGuard& operator=(const readGuard&) = delete;
 
 
-    constexpr void shiftRight(const keyType& difference = keyType(1))
-    {
-        std::vector<typename decltype(this->m_map)::node_type> nodes;
-        nodes.reserve(this->m_map.size());
+        ~readGuard() 
+        { 
+            compressedVectorEpochDomain::exit(); 
+        }
 
-        for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); )
-        {
-            nodes.push_back(this->m_map.extract(it++));
 
-            nodes.back().key() += difference;
-        }
+        [[nodiscard]] const vectorType& operator*(void) const noexcept { return *this->m_vector; }
 
-        for ( auto& node : nodes )
-            this->m_map.insert(this->m_map.cend(), std::move(node));
+        [[nodiscard]] const vectorType* operator->(void) const noexcept { return this->m_vector; }
+    };
 
-        this->minIndex += difference;
 
-        this->maxIndex += difference;
-    }
+    explicit rcuCompressedVector(vectorType initial = {}): m_current{ new vectorType(std::move(initial)) }, m_writerMutex{}, m_retired{} {}
 
 
-    constexpr void shiftRangeLeft
-    (
-        const keyType& from, 
-        const keyType& to, 
-        const keyType& difference = keyType(1), 
-        const valueType& fillValue = valueType(0)
-    )
-    {
-        // TODO
-    }
+    rcuCompressedVector(const rcuCompressedVector<vectorType>&) = delete;
 
+    rcuCompressedVector<vectorType>& operator=(const rcuCompressedVector<vectorType>&) = delete;
 
-    constexpr void shiftRangeRight
-    (
-        const keyType& from, 
-        const keyType& to, 
-        const keyType& difference = keyType(1), 
-        const valueType& fillValue = valueType(0)
-    )
+
+    ~rcuCompressedVector()
     {
-        // TODO
+        for ( const auto& [epoch, retired] : this->m_retired )
+            delete retired;
+
+        delete this->m_current.load(std::memory_order_relaxed);
     }
 
 
-    constexpr void reverseValues(void)
+    [[nodiscard]] readGuard snapshot(void) const
     {
-        this->reverseValues(this->minIndex, this->maxIndex);
+        return readGuard{ this->m_current };
     }
 
 
-    constexpr void reverseValues
-    (
-        const keyType& fromArg, 
-        const keyType& toArg
-    )
+    template<class functionType>
+    decltype(auto) read(functionType&& function) const
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
-
-        if ( from == to or this->m_map.empty() )
-            return;
-
-        auto itBegin = this->m_map.lower_bound(from);
-        auto itEnd = this->m_map.lower_bound(to);
-
-        if ( itBegin == itEnd )
-            return;
-
-        const auto prevItBeginValue = ( itBegin not_eq this->m_map.cbegin() ? std::prev(itBegin)->second : this->m_valBegin );
+        const readGuard guard { this->m_current };
 
-        const bool insertExtraNode = from not_eq itBegin->first;
+        return std::forward<functionType>(function)(*guard);
+    }
 
-        if ( itEnd not_eq this->m_map.cend() and to not_eq itEnd->first )
-            itEnd = this->m_map.emplace_hint(itEnd, to, std::prev(itEnd)->second);
 
-        std::vector<typename decltype(this->m_map)::node_type> nodes;
-        nodes.reserve(( std::size_t ) std::distance(itBegin, itEnd));
+    [[nodiscard]] valueType operator[](const keyType& key) const
+    {
+        return this->read([&key](const vectorType& vector) -> valueType { return vector[key]; });
+    }
 
-        for ( auto it = itBegin; it not_eq itEnd; )
-            nodes.push_back(std::move(this->m_map.extract(it++)));
 
-        auto currentIndex = from, prevIndex = to;
+    [[nodiscard]] valueType getSum(const keyType& from, const keyType& to, const valueType& init = valueType(0)) const
+    {
+        return this->read([&](const vectorType& vector) { return vector.getSum(from, to, init); });
+    }
 
-        auto it = nodes.rbegin();
 
-        if ( it->mapped() == prevItBeginValue )
-            currentIndex += ( to - ( prevIndex = (it++)->key() ) );
+    template<class functionType>
+    void update(functionType&& function)
+    {
+        const std::scoped_lock lock { this->m_writerMutex };
 
-        for ( ; it not_eq nodes.rend(); ++it )
-        {
-            const auto newCurrentIndex = currentIndex + prevIndex - it->key();
+        auto next = std::make_unique<vectorType>(*this->m_current.load(std::memory_order_relaxed));
 
-            prevIndex = it->key();
+        std::forward<functionType>(function)(*next);
 
-            it->key() = currentIndex;
+        this->publish(std::move(next));
+    }
 
-            currentIndex = newCurrentIndex;
 
-            this->m_map.insert(itEnd, std::move(*it));
-        }
+    void store(vectorType vector)
+    {
+        const std::scoped_lock lock { this->m_writerMutex };
 
-        if ( insertExtraNode )
-            this->m_map.emplace_hint(itEnd, currentIndex, prevItBeginValue);
+        this->publish(std::make_unique<vectorType>(std::move(vector)));
+    }
 
-        if ( itEnd not_eq this->m_map.cend() and itEnd->second == std::prev(itEnd)->second )
-            this->m_map.erase(itEnd);
 
-        if ( this->m_map.crbegin()->second not_eq this->m_valBegin )
-            this->m_map.emplace_hint(this->m_map.cend(), to, this->m_valBegin);
+    void assignValue(const keyType& from, const keyType& to, const valueType& value)
+    {
+        this->update([&](vectorType& vector) { vector.assignValue(from, to, value); });
     }
 
 
-    constexpr void sortValues
-    (
-        const bool reverse = false,
-        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
-    )
+    void reclaim(void)
     {
-        this->sortValues(this->minIndex, this->maxIndex, reverse, compareFunction);
+        const std::scoped_lock lock { this->m_writerMutex };
+
+        this->reclaimRetired();
     }
 
 
-    constexpr void sortValues
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const bool reverse = false,
-        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
-    )
+    [[nodiscard]] std::size_t getRetiredCount(void)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        const std::scoped_lock lock { this->m_writerMutex };
 
-        if ( from == to or this->m_map.empty() )
-            return;
+        return this->m_retired.size();
+    }
+};
 
-        auto itBegin = this->m_map.lower_bound(from);
-        auto itEnd = this->m_map.lower_bound(to);
 
-        if ( itBegin == itEnd )
-            return;
+template<class vectorType>
+class seqlockCompressedVector
+{
+    using keyType = typename vectorType::key_type;
 
-        const valueType prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
-        const valueType prevItEndVal = ( itEnd == this->m_map.cbegin() ? this->m_valBegin : std::prev(itEnd)->second );
+    using valueType = typename vectorType::value_type;
 
-        auto comparator = [reverse, &compareFunction](const auto& a, const auto& b) { return reverse ? compareFunction(b, a) : compareFunction(a, b); };
+    alignas(64) std::atomic<std::uint64_t> m_sequence { 0 };
 
-        std::map<valueType, std::size_t, decltype(comparator)> orderedValuesMap{ comparator };
+    alignas(64) mutable std::mutex m_writerMutex;
 
-        if ( itBegin->first not_eq from )
-            orderedValuesMap[prevItBeginVal] += ( std::size_t ) ( itBegin->first - from );
+    vectorType m_vector;
 
-        orderedValuesMap[ itEnd not_eq this->m_map.cend() ? std::prev(itEnd)->second : this->m_valBegin ] += ( std::size_t ) ( to - std::prev(itEnd)->first );
+    std::atomic<keyType> m_minIndex;
 
-        for ( auto it = itBegin, itStop = std::prev(itEnd); it not_eq itStop; ++it )
-            orderedValuesMap[it->second] += ( std::size_t ) ( std::next(it)->first - it->first );
-        
-        this->m_map.erase(itBegin, itEnd);
+    std::atomic<keyType> m_maxIndex;
 
-        auto itStart = orderedValuesMap.begin(), itStop = orderedValuesMap.end();
-        auto currentKey = from;    
+    std::atomic<valueType> m_valBegin;
 
-        if ( itStart->first == prevItBeginVal )
-            currentKey += ( keyType ) (itStart++)->second;
 
-        for ( auto& it = itStart; it not_eq itStop; ++it )
-        {
-            this->m_map.emplace_hint(itEnd, currentKey, it->first);
+    // Copies the vector's bounds and initial value into atomics, so optimistic readers never load fields a writer is storing to.
+    void publishHeader(void) noexcept
+    {
+        this->m_minIndex.store(this->m_vector.minIndex, std::memory_order_relaxed);
 
-            currentKey += ( keyType ) it->second;
-        }
+        this->m_maxIndex.store(this->m_vector.maxIndex, std::memory_order_relaxed);
 
-        if ( to not_eq itEnd->first and std::prev(itEnd)->second not_eq prevItEndVal )
-            this->m_map.emplace_hint(itEnd, to, prevItEndVal);
+        this->m_valBegin.store(this->m_vector.m_valBegin, std::memory_order_relaxed);
     }
 
 
-    constexpr void replaceValue
-    (
-        const valueType& oldValue, 
-        const valueType& newValue
-    )
+    // Entries of seqlockFlatMap are stored with relaxed atomics, so loading them the same way keeps a racing read well-defined.
+    template<class T>
+    [[nodiscard]] static T loadRelaxed(const T& source) noexcept
     {
-        this->replaceValue(this->minIndex, this->maxIndex, oldValue, newValue);
+        return std::atomic_ref<T>{ const_cast<T&>(source) }.load(std::memory_order_relaxed);
     }
 
 
-    constexpr void replaceValue
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const valueType& oldValue, 
-        const valueType& newValue
-    )
+    template<class functionType>
+    [[nodiscard]] auto readOptimistic(functionType&& function) const
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        for ( ;; std::this_thread::yield() )
+        {
+            const std::uint64_t sequence { this->m_sequence.load(std::memory_order_acquire) };
 
-        if ( from == to or oldValue == newValue )
-            return;
+            if ( sequence & 1 )
+                continue;
 
-        if ( this->m_map.empty() )
-        {
-            if ( this->m_valBegin == oldValue )
-                this->assignValue(from, to, newValue);
+            const auto result = function(this->m_minIndex.load(std::memory_order_relaxed), this->m_maxIndex.load(std::memory_order_relaxed), this->m_valBegin.load(std::memory_order_relaxed));
 
-            return;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if ( this->m_sequence.load(std::memory_order_relaxed) == sequence )
+                return result;
         }
+    }
 
-        auto itBegin = this->m_map.lower_bound(from);
-        auto itEnd = this->m_map.lower_bound(to);
+public:
 
-        valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
-        valueType& prevItEndVal = ( itEnd == this->m_map.cbegin() ? this->m_valBegin : std::prev(itEnd)->second );
+    using key_type = keyType;
 
-        if ( itBegin == itEnd )
-        {
-            if ( oldValue == prevItBeginVal )
-                this->assignValue(from, to, newValue);
+    using value_type = valueType;
+
+
+    explicit seqlockCompressedVector(vectorType vector = {}): m_vector{ std::move(vector) }, m_minIndex{}, m_maxIndex{}, m_valBegin{}
+    {
+        this->publishHeader();
+    }
+
+
+    seqlockCompressedVector(const seqlockCompressedVector<vectorType>&) = delete;
+
+    seqlockCompressedVector<vectorType>& operator=(const seqlockCompressedVector<vectorType>&) = delete;
 
-            return;
-        }
 
-        if ( from < itBegin->first and oldValue == prevItBeginVal )
+    [[nodiscard]] valueType operator[](const keyType& key) const
+    {
+        return this->readOptimistic([this, &key](const keyType&, const keyType&, const valueType initValue) 
         {
-            this->m_map.emplace_hint(itBegin, from, newValue);
+            return this->m_vector.m_map.readSnapshot([&](const auto keys, const auto values) 
+            {
+                const std::size_t index { ( std::size_t ) ( std::ranges::upper_bound(keys, key, {}, loadRelaxed<keyType>) - keys.begin() ) };
 
-            if ( itBegin->second == newValue )
-                itBegin = this->m_map.erase(itBegin);
-        }
+                return ( index == 0 ? initValue : loadRelaxed(values[index - 1]) );
+            });
+        });
+    }
 
-        if ( to < itEnd->first and oldValue == prevItEndVal )
+
+    [[nodiscard]] valueType getSum(const keyType& fromArg, const keyType& toArg, const valueType& init = valueType(0)) const
+    {
+        return this->readOptimistic([this, &fromArg, &toArg, &init](const keyType minIndex, const keyType maxIndex, const valueType initValue) 
         {
-            this->m_map.emplace_hint(itEnd, to, prevItEndVal);
+            const keyType from { toArg <= fromArg ? fromArg : std::clamp(fromArg, minIndex, maxIndex) }, to { std::clamp(toArg, from, std::max(from, maxIndex)) };
 
-            if ( std::prev(itEnd)->second == itEnd->second )
-                itEnd = this->m_map.erase(itEnd);
-        }
+            return this->m_vector.m_map.readSnapshot([&](const auto keys, const auto values) 
+            {
+                std::size_t index { ( std::size_t ) ( std::ranges::upper_bound(keys, from, {}, loadRelaxed<keyType>) - keys.begin() ) };
 
-        for ( auto it = itBegin ; it not_eq itEnd ; ++it )
-            if ( it->second == oldValue and it->first not_eq to )
-                it->second = newValue;
+                valueType value { index == 0 ? initValue : loadRelaxed(values[index - 1]) }, result { init };
 
-        if ( this->m_map.crbegin()->second not_eq this->m_valBegin )
-            this->m_map.emplace_hint(this->m_map.cend(), this->maxIndex, this->m_valBegin);
+                keyType position { from };
+
+                if ( from == to )
+                    return value;
+
+                for ( keyType key ; index < keys.size() and ( key = loadRelaxed(keys[index]) ) < to ; ++index )
+                {
+                    result += ( valueType ) ( key - position ) * value;
+
+                    position = key;
+
+                    value = loadRelaxed(values[index]);
+                }
+
+                return result + ( valueType ) ( to - position ) * value;
+            });
+        });
     }
 
 
-    constexpr void apply(const std::function<valueType(const valueType&)>& appliedFunction)
+    [[nodiscard]] valueType getSum(void) const
     {
-        this->apply(this->minIndex, this->maxIndex, appliedFunction);
+        return this->getSum(std::numeric_limits<keyType>::lowest(), std::numeric_limits<keyType>::max());
     }
 
 
-    constexpr void apply
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const std::function<valueType(const valueType&)>& appliedFunction
-    )
+    template<class functionType>
+    decltype(auto) read(functionType&& function) const
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        const std::scoped_lock lock { this->m_writerMutex };
 
-        if ( from == to )
-            return ;
+        return std::forward<functionType>(function)(std::as_const(this->m_vector));
+    }
 
-        if ( this->m_map.empty() )
-        {
-            if ( const auto temp = appliedFunction(this->m_valBegin); temp not_eq this->m_valBegin )
-                this->m_map = { { from, temp }, { to, this->m_valBegin } };
 
-            return;
-        }
+    template<class functionType>
+    decltype(auto) update(functionType&& function)
+    {
+        const std::scoped_lock lock { this->m_writerMutex };
 
-        auto itBegin = this->m_map.lower_bound(from);
-        const auto itEnd = this->m_map.lower_bound(to);
+        this->m_sequence.fetch_add(1, std::memory_order_relaxed);
 
-        const valueType prevItEndVal = ( itEnd == this->m_map.cbegin() ? this->m_valBegin : std::prev(itEnd)->second );
+        std::atomic_thread_fence(std::memory_order_release);
 
-        if ( itBegin == itEnd )
+        struct sequenceCloser
         {
-            if ( const auto newValue = appliedFunction(prevItEndVal); newValue not_eq prevItEndVal )
-            {
-                this->m_map.emplace_hint(itEnd, from, newValue);
+            seqlockCompressedVector<vectorType>& owner;
 
-                if ( to < itEnd->first )
-                    this->m_map.emplace_hint(itEnd, to, prevItEndVal);
+            ~sequenceCloser() 
+            { 
+                this->owner.publishHeader();
 
-                else if ( itEnd->second == std::prev(itEnd)->second )
-                    this->m_map.erase(itEnd);
+                this->owner.m_sequence.fetch_add(1, std::memory_order_release); 
             }
+        } closer { *this };
 
-            return;
-        }
+        return std::forward<functionType>(function)(this->m_vector);
+    }
 
-        const valueType prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
 
-        bool itBeginNotChanged = true;
+    void assignValue(const keyType& from, const keyType& to, const valueType& value)
+    {
+        this->update([&](vectorType& vector) { vector.assignValue(from, to, value); });
+    }
+};
+
 
-        if ( from < itBegin->first )
-        {
-            if ( const auto newValue = appliedFunction(prevItBeginVal); newValue not_eq prevItBeginVal )
-            {
-                itBegin = this->m_map.emplace_hint(itBegin, from, newValue);
+template<class vectorType>
+class shardedCompressedVector
+{
+    using keyType = typename vectorType::key_type;
 
-                itBeginNotChanged = false;
+    using valueType = typename vectorType::value_type;
 
-                if ( std::next(itBegin)->second == newValue )
-                    this->m_map.erase(std::next(itBegin));
-            }
-        }
+    std::vector<vectorType> m_shards;
 
-        if ( itBeginNotChanged )
-            itBegin->second = appliedFunction(itBegin->second);
+    std::vector<keyType> m_bounds;
 
-        for ( auto it = std::next(itBegin); it not_eq itEnd; it = ( ( it->second = appliedFunction(it->second) ) == std::prev(it)->second ? this->m_map.erase(it) : std::next(it) ) );
+    std::vector<std::size_t> m_indices;
 
-        if ( itBegin->second == prevItBeginVal )
-            this->m_map.erase(itBegin);
 
-        if ( itEnd == this->m_map.cend() )
-        {
-            if ( this->m_map.crbegin()->second not_eq this->m_valBegin )
-                this->m_map.emplace_hint(this->m_map.cend(), to, this->m_valBegin);
+    [[nodiscard]] std::size_t shardOf(const keyType& key) const
+    {
+        return ( std::size_t ) std::distance(this->m_bounds.cbegin(), std::upper_bound(this->m_bounds.cbegin() + 1, this->m_bounds.cend() - 1, key)) - 1;
+    }
 
-            return;
-        }
 
-        if ( to < itEnd->first )
-        {
-            if ( std::prev(itEnd)->second not_eq prevItEndVal )
-                this->m_map.emplace_hint(itEnd, to, prevItEndVal);
-        }
+    [[nodiscard]] std::pair<keyType, keyType> getValidRange(const keyType& from, const keyType& to) const
+    {
+        if ( to <= from )
+            return { from, from };
 
-        else if ( std::prev(itEnd)->second == itEnd->second )
-            this->m_map.erase(itEnd);
+        return { std::clamp(from, this->m_bounds.front(), this->m_bounds.back()), std::clamp(to, this->m_bounds.front(), this->m_bounds.back()) };
     }
 
 
-    constexpr void operationWithArray
-    (
-        compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& array, 
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const std::function<valueType(const valueType&, const valueType&)>& operation
-    )
+    [[nodiscard]] std::span<const std::size_t> overlappingShards(const keyType& from, const keyType& to) const
     {
-        // TODO +-*/%&|^
+        if ( not ( from < to ) )
+            return {};
+
+        const std::size_t first { this->shardOf(from) };
+
+        return std::span<const std::size_t>{ this->m_indices }.subspan(first, this->shardOf(to - keyType(1)) - first + 1);
     }
 
 
-    [[nodiscard]] constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe> getSubArray
-    (
-        const keyType& fromArg, 
-        const keyType& toArg
-    ) const
+    template<class functionType>
+    void forEachShard(const keyType& fromArg, const keyType& toArg, functionType&& function)
     {
         const auto [from, to] = this->getValidRange(fromArg, toArg);
 
-        if ( from == to )
-            return {};
+        const auto shards = this->overlappingShards(from, to);
 
-        if ( this->m_map.empty() or from >= this->m_map.crbegin()->first or to <= this->m_map.cbegin()->first )
-            return { to, { { from, this->m_valBegin } } };
+        const auto body = [&](const std::size_t index) 
+            { function(this->m_shards[index], std::max(from, this->m_bounds[index]), std::min(to, this->m_bounds[index + 1])); };
 
-        const auto& itBegin = this->m_map.lower_bound(from);
-        const auto& itEnd = this->m_map.lower_bound(to);
+        if ( shards.size() > 1 )
+            std::for_each(std::execution::par, shards.begin(), shards.end(), body);
+        else
+            std::for_each(shards.begin(), shards.end(), body);
+    }
 
-        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
 
-        if ( itBegin == itEnd )
-            return { to, { { from, prevItBeginVal } } };
+    template<class resultType, class mapType, class reduceType>
+    [[nodiscard]] resultType reduceShards(const keyType& fromArg, const keyType& toArg, resultType init, mapType&& map, reduceType&& reduce) const
+    {
+        const auto [from, to] = this->getValidRange(fromArg, toArg);
 
-        std::map<keyType, valueType> resultMap;
+        const auto shards = this->overlappingShards(from, to);
 
-        auto [mapHint, _] = resultMap.emplace(std::prev(itEnd)->first, std::prev(itEnd)->second);
+        return std::transform_reduce(std::execution::par, shards.begin(), shards.end(), std::move(init), reduce, 
+            [&](const std::size_t index) { return map(this->m_shards[index], std::max(from, this->m_bounds[index]), std::min(to, this->m_bounds[index + 1])); });
+    }
 
-        for ( auto it = std::prev(itEnd) ; it not_eq itBegin ; --it )
-            mapHint = resultMap.emplace_hint(mapHint, std::prev(it)->first, std::prev(it)->second);
+public:
 
-        resultMap.emplace_hint(mapHint, from, prevItBeginVal);
+    using key_type = keyType;
 
-        return { to, resultMap };
-    }
+    using value_type = valueType;
 
 
-    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, valueType>> getValues(const bool shrink = false) const
+    shardedCompressedVector
+    (
+        const keyType& minIndexArg, 
+        const keyType& maxIndexArg, 
+        const valueType& initValue = valueType(0), 
+        std::size_t shardCount = std::max(1u, std::thread::hardware_concurrency())
+    )
     {
-        this->getValues(this->minIndex, this->maxIndex, shrink);
-    }
+        const keyType minIndex { std::min(minIndexArg, maxIndexArg) }, maxIndex { std::max(minIndexArg, maxIndexArg) };
 
+        shardCount = std::clamp(shardCount, std::size_t(1), std::max(std::size_t(1), ( std::size_t ) ( maxIndex - minIndex )));
 
-    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, valueType>> getValues
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const bool shrink = false
-    ) const
-    {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        const keyType width { ( maxIndex - minIndex ) / ( keyType ) shardCount };
 
-        if ( from == to ) 
-            return {};
+        this->m_shards.reserve(shardCount);
 
-        if ( this->m_map.empty() )
-            return { { from, to, this->m_valBegin } };
+        for ( std::size_t index = 0 ; index < shardCount ; ++index )
+            this->m_bounds.push_back(minIndex + ( keyType ) index * width);
 
-        const auto itBegin = this->m_map.upper_bound(from);
-        const auto itEnd = this->m_map.upper_bound(to);
+        this->m_bounds.push_back(maxIndex);
 
-        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
-            return { { from, to, this->m_valBegin } };
+        for ( std::size_t index = 0 ; index < shardCount ; ++index )
+            this->m_shards.emplace_back(this->m_bounds[index], this->m_bounds[index + 1], initValue);
 
-        if ( itBegin == itEnd )
-            return { { from, to, std::prev(itBegin)->second } };
+        this->m_indices.resize(shardCount);
 
-        std::vector<std::tuple<keyType, keyType, valueType>> result = { { from, itBegin->first, itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second } };
+        std::iota(this->m_indices.begin(), this->m_indices.end(), std::size_t(0));
+    }
 
-        for ( auto it = std::next(itBegin) ; it not_eq itEnd ; ++it )
-        {
-            const auto& prevIt = std::prev(it);
 
-            result.emplace_back(prevIt->first, it->first, prevIt->second);
-        }
+    [[nodiscard]] keyType getMinIndex(void) const noexcept { return this->m_bounds.front(); }
+
+    [[nodiscard]] keyType getMaxIndex(void) const noexcept { return this->m_bounds.back(); }
+
+    [[nodiscard]] std::size_t getShardCount(void) const noexcept { return this->m_shards.size(); }
+
+    [[nodiscard]] const vectorType& getShard(const std::size_t index) const { return this->m_shards[index]; }
 
-        if ( const auto& prevItEnd = std::prev(itEnd); prevItEnd->first not_eq to )
-            result.emplace_back(prevItEnd->first, to, prevItEnd->second);
+    [[nodiscard]] std::pair<keyType, keyType> getShardRange(const std::size_t index) const { return { this->m_bounds[index], this->m_bounds[index + 1] }; }
 
-        if ( shrink )
-            result.shrink_to_fit();
 
-        return result;
+    [[nodiscard]] valueType operator[](const keyType& key) const
+    {
+        return this->m_shards[this->shardOf(key)][key];
     }
 
 
-    [[nodiscard]] constexpr std::unordered_set<valueType> getSetValues(void) const
+    void assignValue(const keyType& from, const keyType& to, const valueType& value)
     {
-        return this->getRangeSetValues(this->minIndex, this->maxIndex);
+        this->forEachShard(from, to, [&value](vectorType& shard, const keyType& begin, const keyType& end) { shard.assignValue(begin, end, value); });
     }
 
 
-    [[nodiscard]] constexpr std::unordered_set<valueType> getSetValues
-    (
-        const keyType& fromArg, 
-        const keyType& toArg
-    ) const
+    void apply(const keyType& from, const keyType& to, const std::function<valueType(const valueType&)>& appliedFunction)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        this->forEachShard(from, to, [&appliedFunction](vectorType& shard, const keyType& begin, const keyType& end) { shard.apply(begin, end, appliedFunction); });
+    }
 
-        if ( from == to ) 
-            return {};
 
-        if ( this->m_map.empty() )
-            return { this->m_valBegin };
+    void replaceValue(const keyType& from, const keyType& to, const valueType& oldValue, const valueType& newValue)
+    {
+        this->forEachShard(from, to, [&](vectorType& shard, const keyType& begin, const keyType& end) { shard.replaceValue(begin, end, oldValue, newValue); });
+    }
 
-        const auto itBegin = this->m_map.upper_bound(from);
-        const auto itEnd = this->m_map.upper_bound(to);
 
-        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
-            return { this->m_valBegin };
+    [[nodiscard]] valueType getSum(const keyType& from, const keyType& to, const valueType& init = valueType(0)) const
+    {
+        return this->reduceShards(from, to, init, 
+            [](const vectorType& shard, const keyType& begin, const keyType& end) { return shard.getSum(begin, end); }, std::plus<valueType>{});
+    }
 
-        if ( itBegin == itEnd )
-            return { std::prev(itBegin)->second };
 
-        std::unordered_set<valueType> result = { itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second };
+    [[nodiscard]] valueType getSum(void) const
+    {
+        return this->getSum(this->getMinIndex(), this->getMaxIndex());
+    }
 
-        for ( auto it = std::next(itBegin) ; it not_eq itEnd ; ++it )
-        {
-            const auto& prevIt = std::prev(it);
 
-            result.insert(prevIt->second);
-        }
+    [[nodiscard]] valueType getMinValue(const keyType& from, const keyType& to) const
+    {
+        return this->reduceShards(from, to, std::numeric_limits<valueType>::max(), 
+            [](const vectorType& shard, const keyType& begin, const keyType& end) { return shard.getMinValue(begin, end); }, 
+            [](const valueType& a, const valueType& b) { return std::min(a, b); });
+    }
 
-        if ( const auto& prevItEnd = std::prev(itEnd); prevItEnd->first not_eq to )
-            result.insert(prevItEnd->second);
 
-        return result;
+    [[nodiscard]] valueType getMaxValue(const keyType& from, const keyType& to) const
+    {
+        return this->reduceShards(from, to, std::numeric_limits<valueType>::lowest(), 
+            [](const vectorType& shard, const keyType& begin, const keyType& end) { return shard.getMaxValue(begin, end); }, 
+            [](const valueType& a, const valueType& b) { return std::max(a, b); });
     }
 
 
-    [[nodiscard]] constexpr std::map<valueType, std::size_t> getRangeValueFrequencies(void) const
+    [[nodiscard]] std::map<valueType, std::size_t> getRangeValueFrequencies(const keyType& from, const keyType& to) const
     {
-        return this->getRangeValueFrequencies(this->minIndex, this->maxIndex);
+        return this->reduceShards(from, to, std::map<valueType, std::size_t>{}, 
+            [](const vectorType& shard, const keyType& begin, const keyType& end) { return shard.getRangeValueFrequencies(begin, end); }, 
+            [](std::map<valueType, std::size_t> a, const std::map<valueType, std::size_t>& b) 
+            { 
+                for ( const auto& [value, count] : b )
+                    a[value] += count;
+
+                return a; 
+            });
     }
 
 
-    [[nodiscard]] constexpr std::map<valueType, std::size_t> getRangeValueFrequencies
-    (
-        const keyType& fromArg, 
-        const keyType& toArg
-    ) const
+    [[nodiscard]] std::vector<std::tuple<keyType, keyType, valueType>> getValues(const keyType& fromArg, const keyType& toArg) const
     {
         const auto [from, to] = this->getValidRange(fromArg, toArg);
 
-        const auto subArray = this->getSubArray(from, to);
-        subArray.printMapDebug();
+        std::vector<std::tuple<keyType, keyType, valueType>> result;
 
-        const auto& subArrayMapRef = subArray.getMapRef();
-
-        if ( subArrayMapRef.empty() )
-            return {};
+        for ( const std::size_t index : this->overlappingShards(from, to) )
+            for ( const auto& run : this->m_shards[index].getValues(std::max(from, this->m_bounds[index]), std::min(to, this->m_bounds[index + 1])) )
+            {
+                if ( not result.empty() and std::get<2>(result.back()) == std::get<2>(run) and std::get<1>(result.back()) == std::get<0>(run) )
+                    std::get<1>(result.back()) = std::get<1>(run);
+                else
+                    result.push_back(run);
+            }
 
-        if ( subArrayMapRef.size() == 1 )
-            return { { subArrayMapRef.cbegin()->second, to - from } };
+        return result;
+    }
 
-        std::map<valueType, std::size_t> resultMap;
 
-        for ( auto it = std::next(subArrayMapRef.begin()) ; it not_eq subArrayMapRef.cend() ; ++it )
-            resultMap[std::prev(it)->second] += ( std::size_t ) ( it->first - std::prev(it)->first );
+    [[nodiscard]] std::vector<std::tuple<keyType, keyType, valueType>> getValues(void) const
+    {
+        return this->getValues(this->getMinIndex(), this->getMaxIndex());
+    }
+};
 
-        resultMap[subArrayMapRef.crbegin()->second] += ( std::size_t ) ( to - subArrayMapRef.crbegin()->first );
 
-        return resultMap;
-    }
+template<class vectorType> requires ( vectorType::isThreadSafe )
+class combiningCompressedVector
+{
+    using keyType = typename vectorType::key_type;
 
+    using valueType = typename vectorType::value_type;
 
-    [[nodiscard]] constexpr std::vector<std::pair<keyType, keyType>> getValueRanges
-    (
-        const valueType& value, 
-        const bool shrink = false
-    ) const
+    struct updateRecord
     {
-        std::vector<std::pair<keyType, keyType>> result;
+        keyType from;
 
-        if ( value == this->m_valBegin )
-            result.emplace_back(this->minIndex, this->m_map.empty() ? this->maxIndex : this->m_map.cbegin()->first);
+        keyType to;
 
-        for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); ++it )
-        {
-            if ( it->second == value )
-            {
-                const auto& itNext = std::next(it);
+        valueType value;
 
-                result.emplace_back(it->first, itNext not_eq this->m_map.cend() ? itNext->first : this->maxIndex);
+        std::function<valueType(const valueType&)> appliedFunction;
 
-                ++it;
-            }
-        }
+        std::promise<void> done;
 
-        if ( shrink )
-            result.shrink_to_fit();
+        bool completed { false };
+    };
 
-        return result;
-    }
+    alignas(64) std::mutex m_queueMutex;
 
+    std::vector<updateRecord> m_pending;
 
-    [[nodiscard]] constexpr std::unordered_map<valueType, std::vector<std::pair<keyType, keyType>>> getValuesRanges
-    (
-        const std::unordered_set<valueType>& values, 
-        const bool shrink = false
-    ) const
-    {
-        std::unordered_map<valueType, std::vector<std::pair<keyType, keyType>>> result;
+    bool m_combining { false };
+
+    std::size_t m_batchCount { 0 };
 
-        if ( values.contains(this->m_valBegin) )
-            result[this->m_valBegin].emplace_back(this->minIndex, this->m_map.empty() ? this->maxIndex : this->m_map.cbegin()->first);
+    alignas(64) vectorType m_vector;
 
-        for ( auto it = this->m_map.cbegin(); it not_eq this->m_map.cend(); ++it )
+
+    template<class functionType>
+    static void complete(std::span<updateRecord> records, functionType&& function)
+    {
+        try
         {
-            if ( values.contains(it->second) )
+            function();
+
+            for ( auto& record : records )
             {
-                const auto& itNext = std::next(it);
+                record.done.set_value();
 
-                result[it->second].emplace_back(it->first, itNext not_eq this->m_map.cend() ? itNext->first : this->maxIndex);
+                record.completed = true;
             }
         }
+        catch ( ... )
+        {
+            for ( auto& record : records )
+            {
+                record.done.set_exception(std::current_exception());
 
-        if ( shrink )
-            for ( auto& [value, vector] : result )
-                vector.shrink_to_fit();
-
-        return result;
+                record.completed = true;
+            }
+        }
     }
 
 
-    [[nodiscard]] constexpr valueType getMinValue(const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}) const
+    void applyBatch(std::vector<updateRecord>& batch)
     {
-        return this->getMinValue(this->minIndex, this->maxIndex, compareFunction);
-    }
+        [[maybe_unused]] const auto writeLock { this->m_vector.lockWrite() };
 
+        std::vector<std::tuple<keyType, keyType, valueType>> writes;
 
-    [[nodiscard]] constexpr valueType getMinValue
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less<valueType>{}
-    ) const
-    {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        writes.reserve(batch.size());
 
-        if ( from == to )
-            return this->m_valBegin;
+        std::size_t segmentBegin { 0 };
 
-        const auto itBegin = this->m_map.lower_bound(from);
+        const auto flushWrites = [this, &batch, &writes, &segmentBegin](const std::size_t segmentEnd)
+        {
+            if ( not writes.empty() )
+                this->complete(std::span{ batch }.subspan(segmentBegin, segmentEnd - segmentBegin), [this, &writes] 
+                { 
+                    if ( writes.size() == 1 )
+                        std::apply([this](const auto&... write) { this->m_vector.assignValue(write...); }, writes.front());
+                    else
+                        this->m_vector.assignValues(writes); 
+                });
 
-        if ( itBegin == this->m_map.cend() )
-            return this->m_valBegin;
+            writes.clear();
 
-        const valueType& minFirst = ( itBegin->first == from ? itBegin->second : ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second ) );
+            segmentBegin = segmentEnd;
+        };
 
-        const auto itEnd = this->m_map.lower_bound(to);
+        for ( std::size_t index = 0; index < batch.size(); ++index )
+        {
+            auto& record { batch[index] };
+
+            if ( not record.appliedFunction )
+            {
+                writes.emplace_back(record.from, record.to, record.value);
 
-        const valueType& minLast = ( itEnd == this->m_map.cend() or itEnd == this->m_map.cbegin() ? this->m_valBegin : std::prev(itEnd)->second );
+                continue;
+            }
 
-        return std::min(
-            std::min(minFirst, minLast, compareFunction), 
-            std::min_element(std::execution::par_unseq, itBegin, itEnd, 
-                [&compareFunction](const auto& itA, const auto& itB) { return compareFunction(itA.second, itB.second); }
-                )->second, 
-            compareFunction);
-    }
+            flushWrites(index);
 
+            this->complete(std::span{ batch }.subspan(index, 1), [this, &record] { this->m_vector.apply(record.from, record.to, record.appliedFunction); });
 
-    [[nodiscard]] constexpr valueType getMaxValue(const std::function<bool(const valueType&, const valueType&e)>& compareFunction = std::less<valueType>{}) const
-    {
-        return this->getMaxValue(this->minIndex, this->maxIndex, compareFunction);
+            segmentBegin = index + 1;
+        }
+
+        flushWrites(batch.size());
     }
 
 
-    [[nodiscard]] constexpr valueType getMaxValue
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::less{}
-    ) const
+    [[nodiscard]] std::future<void> submit(updateRecord record)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
-
-        if ( from == to )
-            return this->m_valBegin;
+        std::future<void> future { record.done.get_future() };
 
-        const auto itBegin = this->m_map.lower_bound(from);
+        {
+            const std::scoped_lock lock { this->m_queueMutex };
 
-        if ( itBegin == this->m_map.cend() )
-            return this->m_valBegin;
+            this->m_pending.push_back(std::move(record));
 
-        const valueType& minFirst = ( itBegin->first == from ? itBegin->second : ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second ) );
+            if ( this->m_combining )
+                return future;
 
-        const auto itEnd = this->m_map.lower_bound(to);
+            this->m_combining = true;
+        }
 
-        const valueType& minLast = ( itEnd == this->m_map.cend() or itEnd == this->m_map.cbegin() ? this->m_valBegin : std::prev(itEnd)->second );
+        for ( std::vector<updateRecord> batch ;; batch.clear() )
+        {
+            {
+                const std::scoped_lock lock { this->m_queueMutex };
 
-        return std::max(
-            std::max(minFirst, minLast, compareFunction), 
-            std::max_element(std::execution::par_unseq, itBegin, itEnd, 
-                [&compareFunction](const auto& itA, const auto& itB) { return compareFunction(itA.second, itB.second); }
-                )->second, 
-            compareFunction);
-    }
+                if ( this->m_pending.empty() )
+                {
+                    this->m_combining = false;
 
+                    return future;
+                }
 
-    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
-    [[nodiscard]] constexpr valueType getSum(const valueType& init = valueType(0)) const
-    {
-        return this->getSum(this->minIndex, this->maxIndex, init);
-    }
+                batch.swap(this->m_pending);
 
+                ++this->m_batchCount;
+            }
 
-    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
-    [[nodiscard]] constexpr valueType getSum
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const valueType& init = valueType(0)
-    ) const
-    {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+            try
+            {
+                this->applyBatch(batch);
+            }
+            catch ( ... )
+            {
+                this->abandon(batch, std::current_exception());
 
-        if ( from == to )
-            return (*this)[from];
+                throw;
+            }
+        }
+    }
 
-        if ( this->m_map.empty() or to < this->m_map.cbegin()->first or from > this->m_map.crbegin()->first )
-            return init + this->m_valBegin * (to - from);
 
-        const auto itBegin = this->m_map.lower_bound(from);
-        const auto itEnd = this->m_map.lower_bound(to);
+    // Fails every record the combiner can no longer apply and releases the combiner role, so later submitters are not left waiting.
+    void abandon(std::vector<updateRecord>& batch, const std::exception_ptr& error) noexcept
+    {
+        const auto fail = [&error](std::vector<updateRecord>& records)
+        {
+            for ( auto& record : records )
+                if ( not record.completed )
+                {
+                    record.done.set_exception(error);
 
-        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
-        
-        if ( itBegin == itEnd )
-            return init + (to - from) * prevItBeginVal;
+                    record.completed = true;
+                }
+        };
 
-        valueType result { init + ( itBegin->first - from ) * prevItBeginVal };
+        fail(batch);
 
-        for ( auto it = std::next(itBegin); it not_eq itEnd; ++it )
-        {
-            const auto& prevIt = std::prev(it);
+        const std::scoped_lock lock { this->m_queueMutex };
 
-            result += (it->first - prevIt->first) * prevIt->second;
-        }
+        fail(this->m_pending);
 
-        const auto& prevItEnd = std::prev(itEnd);
+        this->m_pending.clear();
 
-        return result + (to - prevItEnd->first) * prevItEnd->second;
+        this->m_combining = false;
     }
 
+public:
 
-    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
-    [[nodiscard]] constexpr valueType getProduct(const valueType& init = valueType(1)) const
-    {
-        return this->getProduct(this->minIndex, this->maxIndex, init);
-    }
-
+    using key_type = keyType;
 
-    template<class = std::enable_if_t<ArithmeticMethodTypes<keyType, valueType>>>
-    [[nodiscard]] constexpr valueType getProduct
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        const valueType& init = valueType(1)
-    ) const
-    {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+    using value_type = valueType;
 
-        if ( from == to )
-            return (*this)[from];
 
-        if ( this->m_map.empty() or to < this->m_map.cbegin()->first or from > this->m_map.crbegin()->first )
-            return init * ( valueType ) std::pow(this->m_valBegin, (to - from));
+    explicit combiningCompressedVector(vectorType vector = {}): m_vector{ std::move(vector) } {}
 
-        const auto itBegin = this->m_map.lower_bound(from);
-        const auto itEnd = this->m_map.lower_bound(to);
 
-        const valueType& prevItBeginVal = ( itBegin == this->m_map.cbegin() ? this->m_valBegin : std::prev(itBegin)->second );
-        
-        if ( itBegin == itEnd )
-            return init * ( valueType ) std::pow(prevItBeginVal, (to - from)) ;
+    combiningCompressedVector(const combiningCompressedVector<vectorType>&) = delete;
 
-        valueType result { init * ( valueType ) std::pow(prevItBeginVal, (itBegin->first - from)) };
+    combiningCompressedVector<vectorType>& operator=(const combiningCompressedVector<vectorType>&) = delete;
 
-        for ( auto it = std::next(itBegin); it not_eq itEnd; ++it )
-        {
-            const auto& prevIt = std::prev(it);
 
-            result *= ( valueType ) std::pow(prevIt->second, (it->first - prevIt->first)) ;
-        }
+    [[nodiscard]] std::future<void> assignValueAsync(const keyType& from, const keyType& to, const valueType& value)
+    {
+        return this->submit(updateRecord{ from, to, value, {}, {} });
+    }
 
-        const auto& prevItEnd = std::prev(itEnd);
 
-        return result * ( valueType ) std::pow(prevItEnd->second, (to - prevItEnd->first));
+    [[nodiscard]] std::future<void> applyAsync(const keyType& from, const keyType& to, std::function<valueType(const valueType&)> appliedFunction)
+    {
+        return this->submit(updateRecord{ from, to, valueType{}, std::move(appliedFunction), {} });
     }
 
 
-    [[nodiscard]] constexpr std::vector<std::tuple<keyType, keyType, bool>> compareWithArray
-    (
-        compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& array, 
-        const keyType& fromArgLeft, 
-        const keyType& toArgLeft,
-        const keyType& fromArgRight, 
-        const keyType& toArgRight,
-        const std::function<bool(const valueType&, const valueType&)>& compareFunction = std::equal_to<valueType>{}
-    ) const
+    void assignValue(const keyType& from, const keyType& to, const valueType& value)
     {
-        const auto [fromLeft, toLeft] = this->getValidRange(fromArgLeft, toArgLeft);
-        const auto [fromRight, toRight] = array.getValidRange(fromArgRight, toArgRight);
+        this->assignValueAsync(from, to, value).get();
+    }
 
-        if ( fromLeft == toLeft or fromRight == toRight or ( toLeft -  fromLeft ) not_eq ( toRight - fromRight ) )
-            return {};
 
-        const auto valuesLeft = this->getValues(fromLeft, toLeft);
-        const auto valuesRight = array.getValues(fromRight, toRight);
-        // TODO
+    void apply(const keyType& from, const keyType& to, std::function<valueType(const valueType&)> appliedFunction)
+    {
+        this->applyAsync(from, to, std::move(appliedFunction)).get();
     }
 
 
-    [[nodiscard]] constexpr std::vector<valueType> uncompressToVector(void) const
+    [[nodiscard]] const vectorType& getVector(void) const noexcept
     {
-        return this->uncompressToVector(this->minIndex, this->maxIndex);
+        return this->m_vector;
     }
 
 
-    [[nodiscard]] constexpr std::vector<valueType> uncompressToVector
-    (
-        const keyType& fromArg, 
-        const keyType& toArg
-    ) const
+    [[nodiscard]] std::size_t getBatchCount(void)
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        const std::scoped_lock lock { this->m_queueMutex };
 
-        if ( from == to )
-            return {};
+        return this->m_batchCount;
+    }
+};
 
-        const auto length = ( std::size_t ) std::llround(std::ceil(to - from));
 
-        if ( constexpr std::vector<valueType> temp; length > temp.max_size() )
-            return {};
+template<class derivedType>
+class compressedExpressionBase
+{
+public:
 
-        if ( this->m_map.empty() )
-            return std::vector<valueType>(length , this->m_valBegin );
+    static constexpr bool isCompressedExpression { true };
 
-        const auto& itBegin = this->m_map.lower_bound(from);
-        const auto& itEnd = this->m_map.lower_bound(to);
 
-        if ( itEnd == this->m_map.cbegin() or itBegin == this->m_map.cend() )
-            return std::vector<valueType>(length, this->m_valBegin );
+    template<bool extraThreadSafe = false>
+    [[nodiscard]] constexpr auto lockOperands(const compressedVectorLockRequest& extra = { nullptr, false }) const
+    {
+        if constexpr ( derivedType::isThreadSafe or extraThreadSafe )
+        {
+            std::array<compressedVectorLockRequest, derivedType::lockCount + 1> requests {};
 
-        if ( itBegin == itEnd )
-            return std::vector<valueType>(length, std::prev(itBegin)->second );
+            auto* output = requests.data();
 
-        std::vector<valueType> result;
-        result.resize(length);
+            *output++ = extra;
 
-        std::size_t size { ( std::size_t ) std::llround(std::ceil(itBegin->first - from)) };
+            static_cast<const derivedType&>(*this).collectLocks(output);
 
-        auto itResult = result.begin();
+            return compressedVectorLock<derivedType::lockCount + 1>{ requests };
+        }
+        else
+            return compressedVectorNoLock{};
+    }
 
-        std::fill_n(std::execution::par_unseq, itResult, size, itBegin not_eq this->m_map.cbegin() ? std::prev(itBegin)->second : this->m_valBegin);
 
-        std::advance(itResult, size);
+    template<class keyType, class functionType>
+    constexpr void forEachRun(const keyType& from, const keyType& to, functionType&& function) const
+    {
+        if ( not ( from < to ) )
+            return;
+
+        [[maybe_unused]] const auto operandsLock { this->lockOperands() };
+
+        derivedType cursor { static_cast<const derivedType&>(*this) };
 
-        for ( auto it = next(itBegin) ; it not_eq itEnd ; ++it )
+        cursor.seek(from);
+
+        for ( keyType key { from } ; key < to ; )
         {
-            size = ( std::size_t ) ( std::llround(std::ceil(it->first - std::prev(it)->first)) );
+            const keyType next { cursor.nextKey(to) };
 
-            std::fill_n(std::execution::par_unseq, itResult, size, std::prev(it)->second);
+            function(key, next, cursor.value());
 
-            std::advance(itResult, size);
+            key = next;
+
+            cursor.advance(key);
         }
+    }
 
-        std::fill_n(std::execution::par_unseq, itResult, ( std::size_t ) ( std::llround(std::ceil(to - std::prev(itEnd)->first)) ), std::prev(itEnd)->second);
 
-        return result;
+    template<class keyType, class resultType, class reductionType>
+    [[nodiscard]] constexpr resultType reduce(const keyType& from, const keyType& to, resultType init, reductionType&& reduction) const
+    {
+        this->forEachRun(from, to, [&init, &reduction](const keyType& begin, const keyType& end, const auto& value) 
+            { init = reduction(std::move(init), end - begin, value); });
+
+        return init;
     }
 
 
-    void print
-    (
-        bool uncopressed = false, 
-        std::ostream& os = std::cout, 
-        const bool newLine = true, 
-        const short prec = 3
-    ) const
+    template<class keyType, class valueType>
+    [[nodiscard]] constexpr valueType getSum(const keyType& from, const keyType& to, const valueType& init) const
     {
-        this->print(this->minIndex, this->maxIndex, uncopressed, os, newLine, prec);
+        return this->reduce(from, to, init, 
+            [](const valueType& result, const keyType& length, const auto& value) { return result + ( valueType ) length * value; });
     }
 
 
-    void print
-    (
-        const keyType& fromArg, 
-        const keyType& toArg, 
-        bool uncopressed = false, 
-        std::ostream& os = std::cout, 
-        const bool newLine = true, 
-        const short prec = 3
-    ) const
+    [[nodiscard]] constexpr auto getSum(void) const
     {
-        const auto [from, to] = this->getValidRange(fromArg, toArg);
+        const auto& self = static_cast<const derivedType&>(*this);
 
-        if ( from == to )
-            return;
+        using valueType = typename derivedType::value_type;
 
-        const auto currPrec = os.precision();
+        return this->getSum(self.getMinIndex(), self.getMaxIndex(), valueType(0));
+    }
+};
 
-        constexpr bool isFloating = std::is_floating_point_v<keyType> or std::is_floating_point_v<valueType>;
 
-        if constexpr ( isFloating )
-            os.precision(prec);
+template<class vectorType>
+class compressedVectorTerminal : public compressedExpressionBase<compressedVectorTerminal<vectorType>>
+{
+    using keyType = typename vectorType::key_type;
 
-        if ( newLine )
-            os << "\n";
+    using valueType = typename vectorType::value_type;
 
-        if ( uncopressed )
-        {
-            for ( const auto item : uncompressToVector(from, to) )
-                os << item << " ";
+    using mapIterator = decltype(std::declval<const vectorType&>().m_map.cbegin());
 
-            os.flush();
+    const vectorType* m_vector;
 
-            if constexpr ( isFloating )
-                os.precision(currPrec);
+    keyType m_from, m_to;
 
-            return;
-        }
+    mapIterator m_next;
 
-        if ( this->m_map.empty() )
-        {
-            os << this->minIndex << " | (" << this->m_valBegin << ", " << this->maxIndex - this->minIndex << ") | " << this->maxIndex;
-            
-            os.flush();
+    const valueType* m_value;
 
-            if constexpr ( isFloating )
-                os.precision(currPrec);
+public:
 
-            return;
-        }
+    using key_type = keyType;
 
-        os << this->minIndex << " | ";
+    using value_type = valueType;
 
-        const auto subArrayMap = this->getSubArray(from, to).m_map;
-        
-        for ( auto it = subArrayMap.cbegin(); it not_eq subArrayMap.cend(); ++it )
-        {
-            if ( std::next(it) not_eq subArrayMap.cend() )
-                os << "(" << it->second << ", " << std::next(it)->first - it->first << "), ";
+    static constexpr bool isArithmeticSafe { vectorType::isArithmeticSafe };
 
-            else
-                os << "(" << it->second << ", " << this->maxIndex - it->first << ")";
-        }
+    static constexpr bool isThreadSafe { vectorType::isThreadSafe };
 
-        os << " | " << this->maxIndex;
+    static constexpr std::size_t lockCount { 1 };
 
-        os.flush();
 
-        if constexpr ( isFloating )
-            os.precision(currPrec);
-    }
+    constexpr explicit compressedVectorTerminal(const vectorType& vector): 
+        compressedVectorTerminal(vector, vector.getMinIndex(), vector.getMaxIndex()) {}
 
 
-    friend std::ostream& operator<<(std::ostream& os, const compressedVector<keyType, valueType, arithmeticSafe, threadSafe>& array)
-    {
-        array.print(array.getMinIndex(), array.getMaxIndex(), false, os);
+    constexpr compressedVectorTerminal(const vectorType& vector, const keyType& from, const keyType& to): 
+        m_vector{ &vector }, m_from{ from }, m_to{ to }, m_next{}, m_value{ &vector.m_valBegin } {}
 
-        return os;
+
+    constexpr void collectLocks(compressedVectorLockRequest*& requests) const
+    {
+        *requests++ = this->m_vector->lockRequest(false);
     }
 
 
-    [[maybe_unused]] bool toFile
-    (
-        std::string_view filePath, 
-        const keyType& from, 
-        const keyType& to, 
-        bool append = false, 
-        bool uncopressed = false, 
-        bool trimEdges = true, const short prec = 3
-    ) const
+    [[nodiscard]] constexpr keyType getMinIndex(void) const noexcept { return this->m_from; }
+
+    [[nodiscard]] constexpr keyType getMaxIndex(void) const noexcept { return this->m_to; }
+
+    [[nodiscard]] constexpr const valueType& getInitialValue(void) const noexcept { return this->m_vector->m_valBegin; }
+
+    [[nodiscard]] constexpr const valueType& value(void) const noexcept { return *this->m_value; }
+
+
+    constexpr void seek(const keyType& key)
     {
-        std::ofstream ostrm(filePath, append ? std::ios::app : std::ios::out);
+        const auto& map = this->m_vector->m_map;
 
-        if ( not ostrm.is_open() )
-            return false;
+        this->m_next = map.upper_bound(key);
 
-        this->print(from, to, uncopressed, ostrm, trimEdges, false, prec);
+        this->m_value = ( this->m_next == map.cbegin() ? &this->m_vector->m_valBegin : &std::prev(this->m_next)->second );
+    }
 
-        return true;
+
+    [[nodiscard]] constexpr keyType nextKey(const keyType& limit) const
+    {
+        return ( this->m_next not_eq this->m_vector->m_map.cend() and this->m_next->first < limit ? this->m_next->first : limit );
     }
 
 
-    [[nodiscard]] static constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe> compress
-    (
-        const std::span<const valueType> buffer, 
-        keyType startIndex = keyType(0), 
-        const valueType& initValue = valueType(0), 
-        double* ratio = nullptr
-    )
+    constexpr void advance(const keyType& key)
     {
-        if ( buffer.empty() )
-        {
-            if ( ratio )
-                *ratio = 0.0;
+        for ( const auto itEnd = this->m_vector->m_map.cend(); this->m_next not_eq itEnd and this->m_next->first <= key; ++this->m_next )
+            this->m_value = &this->m_next->second;
+    }
+};
 
-            return { startIndex, initValue, {} };
-        }
 
-        std::size_t count { 1 };
+template<class leftType, class rightType, class operationType>
+class compressedVectorExpression : public compressedExpressionBase<compressedVectorExpression<leftType, rightType, operationType>>
+{
+    using keyType = typename leftType::key_type;
 
-        valueType value { buffer.front() };
+    using valueType = typename leftType::value_type;
 
-        std::vector<std::pair<valueType, std::size_t>> values;
+    leftType m_left;
 
-        for ( auto it = std::next(buffer.begin()); it not_eq buffer.end(); ++it )
-        {
-            if ( *it == value )
-                ++count;
+    rightType m_right;
 
-            else
-            {
-                values.emplace_back(value, count);
+    [[no_unique_address]] operationType m_operation;
 
-                value = *it;
+public:
 
-                count = 1;
-            }
-        }
+    using key_type = keyType;
 
-        values.emplace_back(value, count);
+    using value_type = valueType;
 
-        compressedVector<keyType, valueType, arithmeticSafe, threadSafe> resultArray { startIndex, initValue, values };
+    static constexpr bool isArithmeticSafe { leftType::isArithmeticSafe };
 
-        if ( ratio )
-            *ratio = ( double ) resultArray.getByteSize() / ( double ) ( buffer.size() * sizeof(valueType) );
+    static constexpr bool isThreadSafe { leftType::isThreadSafe or rightType::isThreadSafe };
 
-        return resultArray;
-    }
+    static constexpr std::size_t lockCount { leftType::lockCount + rightType::lockCount };
 
 
-    [[nodiscard]] static constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe> compressFromFile
-    (
-        std::string_view filePath, 
-        const std::size_t indexFromStart = 0, 
-        const std::size_t indexFromEnd = 0, 
-        const valueType& initValue = valueType(0), 
-        double* ratio = nullptr
-    )
-    {
-        std::ifstream file(filePath.data());
+    constexpr compressedVectorExpression(const leftType& left, const rightType& right, const operationType& operation): 
+        m_left{ left }, m_right{ right }, m_operation{ operation } {}
 
-        if ( not file.is_open() )
-            return {};
 
-        std::size_t total { 0 };
+    constexpr void collectLocks(compressedVectorLockRequest*& requests) const
+    {
+        this->m_left.collectLocks(requests);
 
-        valueType number;
+        this->m_right.collectLocks(requests);
+    }
 
-        while(file >> number)
-            ++total;
 
-        if ( total == 0 )
-            return {};
+    [[nodiscard]] constexpr keyType getMinIndex(void) const { return this->m_left.getMinIndex(); }
 
-        file.clear();
-        file.seekg(0);
+    [[nodiscard]] constexpr keyType getMaxIndex(void) const { return this->m_left.getMaxIndex(); }
 
-        const auto endIndex = total - indexFromEnd, length = endIndex - indexFromStart;
+    // The leftmost operand's initial value, untouched by the operation, as c = a; c op= b would keep it.
+    [[nodiscard]] constexpr const valueType& getInitialValue(void) const noexcept { return this->m_left.getInitialValue(); }
 
-        std::vector<valueType> values;
-        values.reserve(length);
+    [[nodiscard]] constexpr valueType value(void) const { return this->m_operation(this->m_left.value(), this->m_right.value()); }
 
-        for ( std::size_t index { 0 }; index < indexFromStart; ++index )
-            file >> number;
 
-        for ( std::size_t index { indexFromStart }; index < endIndex; ++index )
-        {
-            file >> number;
+    constexpr void seek(const keyType& key)
+    {
+        this->m_left.seek(key);
+
+        this->m_right.seek(key);
+    }
 
-            values.emplace_back(number);
-        }
 
-        return compressedVector<keyType, valueType, arithmeticSafe, threadSafe>::compress(values, 0, initValue, ratio);
+    [[nodiscard]] constexpr keyType nextKey(const keyType& limit) const
+    {
+        return this->m_right.nextKey(this->m_left.nextKey(limit));
     }
 
 
-    [[nodiscard]] static constexpr compressedVector<keyType, valueType, arithmeticSafe, threadSafe> compressFromFileParts
-    (
-        std::string_view filePath,
-        const std::vector<std::pair<const std::size_t, const std::size_t>>& ranges,
-        const valueType& initValue = valueType(0), 
-        double* ratio = nullptr
-    )
+    constexpr void advance(const keyType& key)
     {
-        if ( ranges.empty() )
-            return {};
+        this->m_left.advance(key);
 
-        std::ifstream file(filePath.data());
+        this->m_right.advance(key);
+    }
+};
 
-        if ( not file.is_open() )
-            return {};
 
-        std::size_t total { 0 };
+template<BigInteger keyType, class valueType, bool arithmeticSafe, bool threadSafe, template<class...> class storageType>
+[[nodiscard]] constexpr auto asExpression(const compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>& vector)
+{
+    return compressedVectorTerminal<compressedVector<keyType, valueType, arithmeticSafe, threadSafe, storageType>>{ vector };
+}
 
-        valueType number;
 
-        while(file >> number)
-            ++total;
+template<class vectorType>
+[[nodiscard]] constexpr auto asExpression(const compressedVectorView<vectorType>& view)
+{
+    return compressedVectorTerminal<vectorType>{ view.getVector(), view.getMinIndex(), view.getMaxIndex() };
+}
 
-        if ( total == 0 )
-            return {};
 
-        file.clear();
-        file.seekg(0);
+template<CompressedExpression expressionType>
+[[nodiscard]] constexpr const expressionType& asExpression(const expressionType& expression)
+{
+    return expression;
+}
+
 
-        std::vector<std::pair<std::size_t, std::size_t>> rangesFixedTemp, rangesFixed;
-        rangesFixedTemp.reserve(ranges.size());
-        rangesFixed.reserve(ranges.size());
+template<class T> concept CompressedOperand = requires(const T& operand) { asExpression(operand); };
 
-        std::copy_if(std::execution::par_unseq, ranges.begin(), ranges.end(), std::back_inserter(rangesFixedTemp), [&total](const auto& p) { return p.first < p.second and p.second <= total; });
+template<class leftType, class rightType> concept CompressedOperands = CompressedOperand<leftType> and CompressedOperand<rightType> and 
+    std::is_same_v<typename std::remove_cvref_t<decltype(asExpression(std::declval<const leftType&>()))>::value_type, 
+                   typename std::remove_cvref_t<decltype(asExpression(std::declval<const rightType&>()))>::value_type>;
 
-        if ( rangesFixedTemp.empty() )
-            return {};
 
-        std::sort(std::execution::par_unseq, rangesFixedTemp.begin(), rangesFixedTemp.end());
+template<class leftType, class rightType, class operationType>
+[[nodiscard]] constexpr auto makeExpression(const leftType& left, const rightType& right, const operationType& operation)
+{
+    using leftExpression = std::remove_cvref_t<decltype(asExpression(left))>;
 
-        rangesFixed.emplace_back(rangesFixedTemp.front());
+    using rightExpression = std::remove_cvref_t<decltype(asExpression(right))>;
 
-        for ( auto it = std::next(rangesFixedTemp.cbegin()); it not_eq rangesFixedTemp.cend(); ++it )
-            if ( it->first >= rangesFixed.back().second )
-                rangesFixed.emplace_back(*it);
+    return compressedVectorExpression<leftExpression, rightExpression, operationType>{ asExpression(left), asExpression(right), operation };
+}
 
-        rangesFixedTemp.clear();
 
-        std::size_t valueIndex { 0 }, rangeIndex { 0 }, from, to;
+template<class leftType, class rightType>
+using expressionValueType = typename std::remove_cvref_t<decltype(asExpression(std::declval<const leftType&>()))>::value_type;
 
-        std::tie(from, to) = rangesFixed[rangeIndex];
 
-        std::vector<valueType> values;
+template<class leftType, class rightType>
+constexpr bool expressionSafety = std::remove_cvref_t<decltype(asExpression(std::declval<const leftType&>()))>::isArithmeticSafe;
 
-        while ( file >> number )
-        {
-            if ( from <= valueIndex and valueIndex < to )
-                values.emplace_back(number);
 
-            else if ( to <= valueIndex )
-            {
-                std::tie(from, to) = rangesFixed[++rangeIndex];
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::is_arithmetic_v<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator+(const leftType& left, const rightType& right)
+{
+    using T = expressionValueType<leftType, rightType>;
 
-                if ( from <= valueIndex and valueIndex < to )
-                    values.emplace_back(number);
-            }
+    return makeExpression(left, right, [](const T& a, const T& b) { return safeAdd<T, expressionSafety<leftType, rightType>>(a, b); });
+}
 
-            ++valueIndex;
-        }
 
-        return compressedVector<keyType, valueType, arithmeticSafe, threadSafe>::compress(values, 0, initValue, ratio);
-    }
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::is_arithmetic_v<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator-(const leftType& left, const rightType& right)
+{
+    using T = expressionValueType<leftType, rightType>;
 
+    return makeExpression(left, right, [](const T& a, const T& b) { return safeSubstract<T, expressionSafety<leftType, rightType>>(a, b); });
+}
 
-    [[nodiscard]] bool mapCanonicalValidationDebug(void) const 
-    {
-        return 
-        this->m_map.size() not_eq 1
-        and 
-        ( this->m_map.empty() or ( this->m_valBegin == this->m_map.crbegin()->second and this->m_valBegin not_eq this->m_map.cbegin()->second ) )
-        and
-        std::adjacent_find(std::execution::par_unseq, this->m_map.cbegin(), this->m_map.cend(), 
-            [](const auto& a, const auto& b){ return a.second == b.second; }) == this->m_map.cend();
-    }
 
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::is_arithmetic_v<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator*(const leftType& left, const rightType& right)
+{
+    using T = expressionValueType<leftType, rightType>;
 
-    void printMapDebug(void) const
-    {
-        std::cout << std::endl;
+    return makeExpression(left, right, [](const T& a, const T& b) { return safeMultiply<T, expressionSafety<leftType, rightType>>(a, b); });
+}
 
-        if ( this-> m_map.empty() )
-            std::cout << "Map is empty.";
 
-        for ( const auto& [key, value] : this->m_map )
-            std::cout << "(" << key << ", " << value << "), ";
-    }
-};
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::is_arithmetic_v<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator/(const leftType& left, const rightType& right)
+{
+    using T = expressionValueType<leftType, rightType>;
+
+    return makeExpression(left, right, [](const T& a, const T& b) { return safeDivide<T, expressionSafety<leftType, rightType>>(a, b); });
+}
+
+
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::integral<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator%(const leftType& left, const rightType& right)
+{
+    return makeExpression(left, right, std::modulus<expressionValueType<leftType, rightType>>{});
+}
+
+
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::integral<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator&(const leftType& left, const rightType& right)
+{
+    return makeExpression(left, right, std::bit_and<expressionValueType<leftType, rightType>>{});
+}
+
+
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::integral<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator|(const leftType& left, const rightType& right)
+{
+    return makeExpression(left, right, std::bit_or<expressionValueType<leftType, rightType>>{});
+}
+
+
+template<class leftType, class rightType> requires CompressedOperands<leftType, rightType> and std::integral<expressionValueType<leftType, rightType>>
+[[nodiscard]] constexpr auto operator^(const leftType& left, const rightType& right)
+{
+    return makeExpression(left, right, std::bit_xor<expressionValueType<leftType, rightType>>{});
+}
 
 #endif
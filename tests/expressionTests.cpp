@@ -0,0 +1,69 @@
+#include "compressedVector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+
+using testVector = compressedVector<std::uint64_t, std::int64_t>;
+
+
+[[nodiscard]] testVector makeVector(const std::int64_t initValue, const std::int64_t low, const std::int64_t high)
+{
+    testVector vector(0, 100, initValue);
+
+    vector.assignValue(0, 40, low);
+
+    vector.assignValue(40, 100, high);
+
+    vector.assignValue(70, 80, low + high);
+
+    return vector;
+}
+
+
+// c = a op b must hold the same elements, initial value and operator== result as c = a; c op= b.
+template<class expressionType, class compoundType>
+[[nodiscard]] bool sameAsCompound(const testVector& a, const testVector& b, const expressionType& expression, const compoundType& compound)
+{
+    const testVector assigned = expression(a, b);
+
+    testVector accumulated = a;
+
+    compound(accumulated, b);
+
+    return assigned == accumulated and assigned.getInitialValue() == a.getInitialValue() and assigned.mapCanonicalValidationDebug();
+}
+
+
+int main(void)
+{
+    int failures { 0 };
+
+    const auto check = [&failures](const bool passed, const char* name)
+    {
+        if ( not passed )
+        {
+            std::printf("FAILED: %s\n", name);
+
+            ++failures;
+        }
+    };
+
+    for ( const std::int64_t initValue : { 0, 5 } )
+    {
+        const testVector a { makeVector(initValue, 12, 30) }, b { makeVector(0, 4, 3) };
+
+        check(sameAsCompound(a, b, [](const auto& x, const auto& y) { return x + y; }, [](auto& x, const auto& y) { x += y; }), "a + b");
+
+        check(sameAsCompound(a, b, [](const auto& x, const auto& y) { return x - y; }, [](auto& x, const auto& y) { x -= y; }), "a - b");
+
+        check(sameAsCompound(a, b, [](const auto& x, const auto& y) { return x * y; }, [](auto& x, const auto& y) { x *= y; }), "a * b");
+
+        // b's initial value is 0 but no element in range is, so neither path may divide by it.
+        check(sameAsCompound(a, b, [](const auto& x, const auto& y) { return x / y; }, [](auto& x, const auto& y) { x /= y; }), "a / b");
+
+        check(sameAsCompound(a, b, [](const auto& x, const auto& y) { return x % y; }, [](auto& x, const auto& y) { x %= y; }), "a % b");
+    }
+
+    return failures;
+}
@@ -0,0 +1,66 @@
+#include "compressedVector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+
+template<template<class...> class storageType>
+using testVector = compressedVector<std::uint64_t, std::int64_t, false, false, storageType>;
+
+
+// Shifting right and then growing to the left inserts keys below the storage offset.
+template<template<class...> class storageType>
+[[nodiscard]] bool shiftThenExpandLeft(void)
+{
+    testVector<storageType> prepended(0, 10, 0);
+
+    prepended.assignValue(2, 5, 1);
+
+    prepended.shiftRight(100);
+
+    prepended.prependValues({ { 7, 5 } }, true);
+
+    prepended.assignValue(96, 98, 3);
+
+    testVector<storageType> inserted(0, 10, 0);
+
+    inserted.assignValue(2, 5, 1);
+
+    inserted.shiftRight(100);
+
+    inserted.insertValuesAfterPosition(103, { { 7, 5 } }, true);
+
+    inserted.shiftLeft(95);
+
+    return prepended[98] == 7 and prepended[99] == 7 and prepended.getSum() == 30 and prepended.mapCanonicalValidationDebug() and
+           inserted.getValues() == std::vector<std::tuple<std::uint64_t, std::uint64_t, std::int64_t>>{ { 0, 2, 0 }, { 2, 4, 1 }, { 4, 9, 7 }, { 9, 10, 1 }, { 10, 15, 0 } } and
+           inserted.mapCanonicalValidationDebug();
+}
+
+
+int main(void)
+{
+    int failures { 0 };
+
+    const auto check = [&failures](const bool passed, const char* name)
+    {
+        if ( not passed )
+        {
+            std::printf("FAILED: %s\n", name);
+
+            ++failures;
+        }
+    };
+
+    check(shiftThenExpandLeft<std::map>(), "shiftThenExpandLeft<std::map>");
+
+    check(shiftThenExpandLeft<flatMap>(), "shiftThenExpandLeft<flatMap>");
+
+    check(shiftThenExpandLeft<offsetMap>(), "shiftThenExpandLeft<offsetMap>");
+
+    check(shiftThenExpandLeft<offsetFlatMap>(), "shiftThenExpandLeft<offsetFlatMap>");
+
+    check(shiftThenExpandLeft<runLengthTree>(), "shiftThenExpandLeft<runLengthTree>");
+
+    return failures;
+}